@@ -0,0 +1,69 @@
+#ifndef CONTAINMENT_HPP_
+#define CONTAINMENT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+// The containment tree of a set of nested polygons, such as countries holding states holding counties. Every polygon
+// is a child of the smallest polygon that contains it, and polygons contained by nothing are roots.
+//
+// The tree is built once, after which a query only evaluates the children of polygons that contain the point: a lookup
+// costs O(depth x fan-out) winding number evaluations rather than one per polygon in the set.
+//
+// Polygons are expected to be either nested or disjoint, although they may share stretches of boundary. Containment is
+// decided at an interior point of each polygon, so a polygon overlapping one of its siblings is attached below the
+// first polygon holding that point.
+class ContainmentHierarchy {
+public:
+    // Prepares every polygon in the set with the algorithm and computes the tree. Returns nullptr, with the algorithm's
+    // error_message() set, when one of the polygons cannot be prepared.
+    [[nodiscard]] static std::unique_ptr<ContainmentHierarchy> Build(const poly::PolygonSet& polygons,
+                                                                     IWindingNumberAlgorithm& algorithm);
+
+    // Returns the indices of the polygons that contain the point, from the outermost root down to the innermost
+    // polygon, or an empty chain when the point is outside every root. A point counts as contained when its winding
+    // number with respect to the polygon is not zero.
+    std::vector<size_t> ContainingPolygons(float x, float y) const;
+
+    // Same as above, reusing the given vector for the result.
+    void ContainingPolygons(float x, float y, std::vector<size_t>& chain) const;
+
+    // Shape of the tree. parent() is kNoParent for roots.
+    static constexpr size_t kNoParent = SIZE_MAX;
+    size_t size() const noexcept;
+    size_t parent(size_t polygon) const noexcept;
+    std::vector<size_t> children(size_t polygon) const;
+    std::vector<size_t> roots() const;
+    size_t depth() const noexcept;
+
+private:
+    struct Node {
+        float min_x, min_y, max_x, max_y;  // Bounding box, checked before evaluating the polygon.
+        size_t parent;
+        uint32_t first_child;  // A range of child_indices_.
+        uint32_t child_count;
+        std::unique_ptr<IPreparedPolygon> prepared;
+    };
+
+    ContainmentHierarchy() = default;
+
+    bool Contains(const Node& node, float x, float y) const;
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> child_indices_;
+    uint32_t first_root_ = 0;  // Roots are stored after the children of every node.
+    uint32_t root_count_ = 0;
+    size_t depth_ = 0;
+};
+
+}  // namespace winding_number
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef CONVEX_HPP_
+#define CONVEX_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// An engine for convex polygons. The polygon is split at its leftmost and rightmost vertices into a lower and an upper
+// chain, both monotone in x, and a query binary searches each for the wedge of x coordinates between consecutive
+// vertices that holds the point. Only the edges spanning those two wedges can cross the point's vertical ray, so a
+// query costs two O(log n) searches and two edge evaluations, and gives the same answer as a scan, boundary points
+// included.
+//
+// Edges that are vertical up to FuzzyEquals() are kept aside and evaluated on every query, there are only ever a few
+// of them at the polygon's far left and right.
+class ConvexPolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize() and to be convex.
+    explicit ConvexPolygon(const poly::Polygon& polygon);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    void CalculateWindingNumbers2D(const float* x, const float* y, size_t count, int* winding_numbers) const override;
+    Engine engine() const noexcept override;
+
+    // 1 for a counter-clockwise polygon, -1 for a clockwise one, and 0 if it does not enclose any area.
+    int orientation() const noexcept;
+
+    // Whether a normalized polygon turns the same way at every vertex and goes around only once, so that the engine
+    // can be used for it.
+    static bool IsConvex(const poly::Polygon& polygon);
+
+private:
+    struct Chain {
+        std::vector<float> x_vec;  // Vertices in increasing x.
+        std::vector<float> y_vec;
+        bool reversed;  // Whether the polygon walks the chain in decreasing x.
+    };
+
+    struct VerticalEdge {
+        float ax, ay, bx, by;
+        float lo, hi;  // The extent from EdgeXExtent().
+    };
+
+    int ChainContribution(const Chain& chain, float x, float y) const;
+
+    Chain chains_[2];
+    std::vector<VerticalEdge> vertical_edges_;
+    int orientation_ = 0;
+};
+
+}  // namespace winding_number
+
+#endif
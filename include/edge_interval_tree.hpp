@@ -0,0 +1,43 @@
+#ifndef EDGE_INTERVAL_TREE_HPP_
+#define EDGE_INTERVAL_TREE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// An engine that indexes the x-extent of every edge, so that a query only evaluates the edges whose extent contains the
+// query point's x coordinate -- the only edges a vertical ray can cross.
+//
+// The index is an implicit interval tree: edges are sorted by the low end of their extent and each node of a balanced
+// tree laid over that array records the largest high end beneath it. It takes O(n) memory on top of the edges, is built
+// with a single sort, and answers in O(log n + k) for k candidate edges. That makes it a good fit for polygons that are
+// too large to scan but change too often to justify a heavier index.
+class EdgeIntervalTreePolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize().
+    explicit EdgeIntervalTreePolygon(const poly::Polygon& polygon);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    Engine engine() const noexcept override;
+
+    // The number of edges held in the tree.
+    size_t edge_count() const noexcept;
+
+private:
+    struct Edge {
+        float ax, ay, bx, by;
+    };
+
+    std::vector<Edge> edges_;            // Sorted by the low end of their x-extent.
+    std::vector<float> low_x_;           // Low end of each edge's x-extent.
+    std::vector<float> high_x_;          // High end of each edge's x-extent.
+    std::vector<float> subtree_high_x_;  // Largest high end in the subtree rooted at each index.
+};
+
+}  // namespace winding_number
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef GENERALIZED_WINDING_HPP_
+#define GENERALIZED_WINDING_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <poly_io.hpp>
+
+namespace winding_number {
+
+// The generalized winding number of a polyline: the signed angle its edges sweep out as seen from the query point,
+// divided by 2 pi. For a closed polygon this is exactly the winding number away from the boundary (and one half on
+// it). For boundaries that are slightly open or noisy it degrades gracefully to a value near the winding number the
+// boundary was meant to have, where the ray cast in IWindingNumberAlgorithm has to give up.
+//
+// Edges are grouped in a bounding volume hierarchy. Far from a group, its edges are approximated together by a second
+// order Taylor expansion about the group's center (Barnes-Hut style), so queries cost about O(log n) instead of O(n).
+class GeneralizedWindingNumber {
+public:
+    // accuracy is the ratio between a group's distance from the query point and its radius beyond which the
+    // approximation is used. Larger values are slower but closer to CalculateExact().
+    explicit GeneralizedWindingNumber(const poly::Polygon& polyline, float accuracy = 2.f);
+
+    // The approximate generalized winding number at a point.
+    float Calculate(float x, float y) const;
+
+    // The generalized winding number at a point summed edge by edge, in O(n).
+    float CalculateExact(float x, float y) const;
+
+    // The approximate generalized winding number rounded to the nearest integer, as a robust inside (non-zero) or
+    // outside (zero) classification.
+    int CalculateWindingNumber2D(float x, float y) const;
+
+    float accuracy() const noexcept;
+    void accuracy(float accuracy) noexcept;
+
+    size_t edge_count() const noexcept;
+    size_t node_count() const noexcept;
+
+private:
+    struct Edge {
+        float ax, ay, bx, by;
+    };
+
+    // A group of consecutive edges_ along with the moments of its edges about the group's center, integrated along
+    // the edges: of the tangent (the dipole term), of offset x tangent, and of offset x offset x tangent.
+    struct Node {
+        float center_x, center_y;
+        float radius;
+        double tangent[2];
+        double moment[2][2];
+        double second_moment[2][2][2];
+        size_t first_edge, last_edge;
+        int left_child, right_child;  // -1 for leaves.
+    };
+
+    int Build(size_t first_edge, size_t last_edge);
+    double ExactAngle(size_t first_edge, size_t last_edge, float x, float y) const;
+
+    std::vector<Edge> edges_;
+    std::vector<Node> nodes_;
+    float accuracy_;
+};
+
+}  // namespace winding_number
+
+#endif
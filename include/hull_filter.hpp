@@ -0,0 +1,66 @@
+#ifndef HULL_FILTER_HPP_
+#define HULL_FILTER_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <optional>  // A C++17 capable compiler is assumed here.
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// How a series of HullFilteredPolygon queries were answered. Kept by the caller, one per thread, so that threads
+// querying the same polygon do not contend for shared counters.
+struct HullFilterStatistics {
+    size_t query_count = 0;
+    size_t resolved_early_count = 0;  // Settled by the hulls without consulting the fallback.
+
+    float early_resolution_fraction() const noexcept;
+};
+
+// An engine that puts two coarse, conservative approximations of the polygon in front of another engine. The outer
+// hull is a 16-sided polygon bounded by supporting lines of the polygon, so every point outside it has winding number
+// 0. The inner hull is a star of 16 triangles around an interior point, each sized to stay clear of the boundary, so
+// every point inside it shares the winding number of that interior point.
+//
+// Points in either case are settled with a handful of multiplications. Only points in the band between the hulls are
+// passed on to the fallback engine, which makes this a good fit for polygons with heavy boundary detail queried over
+// their whole extent.
+class HullFilteredPolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize(), and the fallback an engine
+    // prepared over the same polygon.
+    HullFilteredPolygon(const poly::Polygon& polygon, std::unique_ptr<IPreparedPolygon> fallback);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    Engine engine() const noexcept override;
+
+    // Same as CalculateWindingNumber2D(), also counting the query in statistics.
+    int CalculateWindingNumber2D(float x, float y, HullFilterStatistics& statistics) const;
+
+    // The winding number of every point inside the inner hull.
+    int inner_winding_number() const noexcept;
+
+    // The fraction of the inner hull's sectors that hold a triangle of non-zero size.
+    float inner_coverage() const noexcept;
+
+private:
+    static constexpr size_t kDirections = 16;
+
+    bool InsideInnerHull(double x, double y) const;
+    bool OutsideOuterHull(double x, double y) const;
+    // The winding number when the hulls settle it.
+    std::optional<int> ResolveEarly(float x, float y) const;
+
+    double center_x_ = 0, center_y_ = 0;
+    double direction_x_[kDirections], direction_y_[kDirections];  // Unit bisectors of the inner hull's sectors.
+    double inner_extent_[kDirections];  // Points of sector k with a smaller projection on its bisector are inside.
+    double outer_extent_[kDirections];  // Points with a larger projection on direction k are outside.
+    int inner_winding_number_ = 0;
+    std::unique_ptr<IPreparedPolygon> fallback_;
+};
+
+}  // namespace winding_number
+
+#endif
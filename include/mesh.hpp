@@ -0,0 +1,29 @@
+#ifndef MESH_HPP_
+#define MESH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace poly {
+
+// TriangleMesh represents a surface in 3 dimensions as a set of triangles over shared vertices. Triangles are expected
+// to be wound counter-clockwise when seen from outside, so that a closed mesh has winding number 1 inside.
+struct TriangleMesh {
+    // Returns the index of the new vertex.
+    uint32_t AppendVertex(float x, float y, float z);
+    void AppendTriangle(uint32_t a, uint32_t b, uint32_t c);
+
+    size_t vertex_count() const;
+    size_t triangle_count() const;
+
+    // data members
+    std::vector<float> x_vec_;
+    std::vector<float> y_vec_;
+    std::vector<float> z_vec_;
+    std::vector<uint32_t> triangles_;  // Three vertex indices per triangle.
+};
+
+}  // namespace poly
+
+#endif
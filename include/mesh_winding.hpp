@@ -0,0 +1,74 @@
+#ifndef MESH_WINDING_HPP_
+#define MESH_WINDING_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <mesh.hpp>
+
+namespace winding_number {
+
+// The generalized winding number of a triangle mesh: the solid angle its triangles subtend at the query point, divided
+// by 4 pi. It is 1 inside a closed, outward facing mesh and 0 outside, and degrades gracefully for meshes with holes or
+// self-intersections -- the 3D counterpart of GeneralizedWindingNumber.
+//
+// Triangles are grouped in a bounding volume hierarchy. Far from a group, its triangles are approximated together by a
+// second order Taylor expansion of the dipole field about the group's center, so queries against large meshes cost
+// about O(log n) instead of O(n).
+class MeshWindingNumber {
+public:
+    // accuracy is the ratio between a group's distance from the query point and its radius beyond which the
+    // approximation is used. Larger values are slower but closer to CalculateExact().
+    explicit MeshWindingNumber(const poly::TriangleMesh& mesh, float accuracy = 2.f);
+
+    // The approximate generalized winding number at a point.
+    float Calculate(float x, float y, float z) const;
+
+    // The generalized winding number at a point summed triangle by triangle, in O(n).
+    float CalculateExact(float x, float y, float z) const;
+
+    // The approximate generalized winding number rounded to the nearest integer, non-zero inside.
+    int CalculateWindingNumber3D(float x, float y, float z) const;
+
+    // Batch form of Calculate() over count points given as separate coordinate arrays.
+    void Calculate(const float* x, const float* y, const float* z, size_t count, float* winding_numbers) const;
+
+    // Evaluates Calculate() at the centers of a voxel grid of size_x * size_y * size_z cubes of the given spacing,
+    // whose first corner is at the origin. Results are laid out with x varying fastest, then y, then z.
+    std::vector<float> CalculateVoxelGrid(float origin_x, float origin_y, float origin_z, float spacing, size_t size_x,
+                                          size_t size_y, size_t size_z) const;
+
+    float accuracy() const noexcept;
+    void accuracy(float accuracy) noexcept;
+
+    size_t triangle_count() const noexcept;
+    size_t node_count() const noexcept;
+
+private:
+    struct Triangle {
+        float ax, ay, az, bx, by, bz, cx, cy, cz;
+    };
+
+    // A group of consecutive triangles_ with the moments of its area weighted normal about the group's center,
+    // integrated over the triangles: the normal itself (the dipole term), offset x normal, and offset x offset x normal.
+    struct Node {
+        float center[3];
+        float radius;
+        double normal[3];
+        double moment[3][3];            // [offset axis][normal axis]
+        double second_moment[3][3][3];  // [offset axis][offset axis][normal axis]
+        size_t first_triangle, last_triangle;
+        int left_child, right_child;  // -1 for leaves.
+    };
+
+    int Build(size_t first_triangle, size_t last_triangle);
+    double ExactSolidAngle(size_t first_triangle, size_t last_triangle, float x, float y, float z) const;
+
+    std::vector<Triangle> triangles_;
+    std::vector<Node> nodes_;
+    float accuracy_;
+};
+
+}  // namespace winding_number
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef MONOTONE_CHAIN_HPP_
+#define MONOTONE_CHAIN_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// An engine that splits a normalized polygon into chains of edges that are strictly monotone in x. Only one edge of a
+// monotone chain can straddle a query point's x coordinate, so a query skips every chain whose x-range misses the point
+// and binary searches the rest, for O(chains * log n) per query instead of O(n).
+//
+// Edges that are vertical up to FuzzyEquals() break chains and are kept aside in their own x-sorted list.
+class MonotoneChainPolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize().
+    explicit MonotoneChainPolygon(const poly::Polygon& polygon);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    Engine engine() const noexcept override;
+
+    // The number of x-monotone chains the polygon was split into. The engine pays off when this is much smaller than
+    // the number of edges.
+    size_t chain_count() const noexcept;
+
+    // The number of (near) vertical edges that sit outside of any chain.
+    size_t vertical_edge_count() const noexcept;
+
+    // Counts the chains a normalized polygon would be split into, without building the engine.
+    static size_t CountChains(const poly::Polygon& polygon);
+
+private:
+    struct Chain {
+        size_t first_vertex;  // Index into x_vec_/y_vec_, vertices run in increasing x.
+        size_t last_vertex;
+        bool reversed;  // Whether the polygon walks the chain in decreasing x.
+    };
+
+    struct VerticalEdge {
+        float ax, ay, bx, by;
+    };
+
+    // Chains and vertical edges are both sorted by the low end of their x-range, with a running maximum of the high
+    // end so that a query can stop scanning back once nothing earlier can reach it.
+    std::vector<Chain> chains_;
+    std::vector<float> chain_min_x_;
+    std::vector<float> chain_max_x_;
+    std::vector<float> chain_reach_;
+    std::vector<float> x_vec_;
+    std::vector<float> y_vec_;
+
+    std::vector<VerticalEdge> vertical_edges_;
+    std::vector<float> vertical_min_x_;
+    std::vector<float> vertical_reach_;
+};
+
+}  // namespace winding_number
+
+#endif
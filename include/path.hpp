@@ -0,0 +1,50 @@
+#ifndef PATH_HPP_
+#define PATH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace poly {
+
+// Path represents an outline in 2 dimensions made of one or more contours, each a series of line segments and
+// quadratic or cubic Bezier curves. Curves are kept as curves, rather than flattened into many short line segments.
+struct Path {
+    enum class Segment : uint8_t {
+        kLine,       // One point: the end point.
+        kQuadratic,  // Two points: the control point and the end point.
+        kCubic,      // Three points: two control points and the end point.
+    };
+
+    struct Contour {
+        size_t first_segment;  // Index into segments_.
+        size_t first_point;    // Index into x_vec_ and y_vec_ of the contour's start point.
+    };
+
+    // Starts a new contour at the given point.
+    void MoveTo(float x, float y);
+
+    // Append a segment to the current contour, starting at the end of the previous one.
+    void LineTo(float x, float y);
+    void QuadraticTo(float control_x, float control_y, float x, float y);
+    void CubicTo(float control1_x, float control1_y, float control2_x, float control2_y, float x, float y);
+
+    // Ensures the current contour ends where it started, with a line segment if necessary.
+    void ClosePath();
+
+    size_t segment_count() const;
+    size_t contour_count() const;
+
+    // The number of points a segment of the given kind consumes.
+    static size_t PointCount(Segment segment);
+
+    // data members
+    std::vector<Contour> contours_;
+    std::vector<Segment> segments_;
+    std::vector<float> x_vec_;
+    std::vector<float> y_vec_;
+};
+
+}  // namespace poly
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef PATH_WINDING_HPP_
+#define PATH_WINDING_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <path.hpp>
+
+namespace winding_number {
+
+// Computes winding numbers with respect to a poly::Path without flattening its curves.
+//
+// At construction every curve is split where its x-derivative vanishes, into pieces that are monotone in x, and the
+// y-range of each piece is cached. A vertical ray then crosses a piece at most once: pieces entirely below the point
+// are skipped and pieces entirely above it are counted from their bounds alone, so the crossing only has to be solved
+// for pieces that straddle the point in both x and y. The cost of a query is proportional to the number of segments,
+// not to any flattening resolution.
+//
+// Line segments follow the same rules as IWindingNumberAlgorithm, including counting points on the outline as inside;
+// points on a curve are treated as left of it in the same way. Each contour is closed with a line segment if needed.
+class PathWindingNumber {
+public:
+    explicit PathWindingNumber(const poly::Path& path);
+
+    int CalculateWindingNumber2D(float x, float y) const;
+
+    // The number of x-monotone pieces the path's segments were split into.
+    size_t piece_count() const noexcept;
+
+private:
+    // A line segment, or an x-monotone piece of a curve reparameterized over t in [0, 1] as cubic polynomials.
+    struct Piece {
+        bool is_line;
+        float start_x, start_y, end_x, end_y;  // Shared exactly with the neighbouring pieces.
+        float min_y, max_y;
+        double x_coefficients[4];  // Highest power of t first.
+        double y_coefficients[4];
+    };
+
+    void AddSegment(const double (&x_points)[4], const double (&y_points)[4], size_t point_count);
+    int PieceContribution(const Piece& piece, float x, float y) const;
+
+    std::vector<Piece> pieces_;
+};
+
+}  // namespace winding_number
+
+#endif
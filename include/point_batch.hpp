@@ -0,0 +1,46 @@
+#ifndef POINT_BATCH_HPP_
+#define POINT_BATCH_HPP_
+
+#include <cstddef>
+
+#include <poly_io.hpp>
+#include <polygon_layout.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// An engine that vectorizes across query points rather than across edges. A batch query takes the points a lane group
+// at a time from the caller's coordinate arrays, broadcasts each edge to every lane and keeps one winding counter per
+// point, so each edge is evaluated for a whole group of points per instruction. A query still visits every edge, which
+// makes this the engine for small polygons queried by many points at once. Single point queries are a plain scan.
+//
+// Larger polygons are walked in tiles sized from the cache sizes detected on first use: a tile of edges that fits in
+// L1 is run against every block of a tile of points that fits in L2 before the next edge tile is loaded, so that batches
+// against polygons larger than the caches do not stream the vertices from memory once per point block.
+class PointBatchPolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize(). Its vertices are stored in the
+    // given layout.
+    explicit PointBatchPolygon(poly::Polygon polygon, poly::VertexLayout layout = poly::VertexLayout::kSeparate);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    void CalculateWindingNumbers2D(const float* x, const float* y, size_t count, int* winding_numbers) const override;
+    Engine engine() const noexcept override;
+
+    // The layout the vertices are stored in.
+    poly::VertexLayout layout() const noexcept;
+
+    // The number of points a batch evaluates per edge visit, points are padded up to a multiple of it.
+    static size_t block_size() noexcept;
+
+    // The number of edges and points in a tile of a batch query.
+    static size_t edge_tile_size() noexcept;
+    static size_t point_tile_size() noexcept;
+
+private:
+    poly::VertexBuffer vertices_;
+};
+
+}  // namespace winding_number
+
+#endif
@@ -1,7 +1,11 @@
 #ifndef POLY_IO_HPP_
 #define POLY_IO_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
 #include <string_view>  // A C++17 capable compiler is assumed here.
 #include <tuple>
 #include <vector>
@@ -26,6 +30,56 @@ struct Polygon {
     std::vector<float> y_vec_;
 };
 
+// PolygonSet is an ordered collection of polygons that are queried together, such as the regions of a map. Polygons
+// are identified by their index in the set.
+struct PolygonSet {
+    void AppendPolygon(Polygon polygon);
+    size_t size() const;
+
+    // data members
+    std::vector<Polygon> polygons_;
+};
+
+// A line of an input file that could not be parsed.
+struct LineError {
+    size_t line;  // 1-based line number in the file.
+    std::string message;
+};
+
+// Why a line could not be parsed.
+enum class ParseErrorKind : uint8_t {
+    kNotAFloat,             // A token does not start with a floating point value.
+    kOutOfRange,            // A token's value does not fit in a float.
+    kMissingPointX,         // The line has no values. Files skip blank and comment lines instead of reporting them.
+    kMissingPointY,         // The line has a single value.
+    kInsufficientGeometry,  // The polygon has fewer than two vertices.
+    kLineTooLong,           // The line is longer than IPolygonReader::max_line_bytes().
+};
+
+// A compact record of a line that could not be parsed.
+struct ParseDiagnostic {
+    uint64_t line;         // 1-based line number in the file.
+    // Offset of the offending token, or of the line for errors about the whole line, in the file's text (after
+    // decompression for compressed files).
+    uint64_t byte_offset;
+    ParseErrorKind kind;
+};
+
+// What a non-throwing read does with lines that cannot be parsed.
+enum class ErrorPolicy {
+    kSkip,     // Skip them without a trace.
+    kStop,     // Stop reading at the first one, keeping the records before it and a diagnostic for it.
+    kCollect,  // Skip them, keeping a diagnostic for each.
+};
+
+// The records read by IPolygonReader::ParsePointsAndPolygonsFromFile() and the diagnostics for the lines it did not
+// read, both in file order.
+struct ParseResult {
+    std::vector<std::tuple<float, float, Polygon>> point_and_polygons;
+    std::vector<ParseDiagnostic> diagnostics;
+    bool stopped = false;  // Whether ErrorPolicy::kStop ended the read before the end of the file.
+};
+
 class IPolygonReader {
 public:
     virtual ~IPolygonReader() = default;
@@ -46,7 +100,47 @@ public:
     // Creates a vector of point/Polygon pairs given a path to a file with one point and one polygon per line, in the
     // format that CreatePointAndPolygonFromString() accepts. This should throw a std::runtime_error if there were any issues
     // opening or parsing the file.
+    //
+    // This and the other file readers below also take files compressed with gzip or zstd, told apart by their magic
+    // bytes. These are decompressed on a thread of their own while the lines decompressed so far are parsed, without
+    // going through the disk, and are always parsed on a single thread.
     virtual std::vector<std::tuple<float, float, Polygon>> ReadPointsAndPolygonsFromFile(std::string_view filepath) = 0;
+
+    // Same as ReadPointsAndPolygonsFromFile(), but splits the file into thread_count ranges of whole lines and parses
+    // each on its own thread, 0 meaning one per hardware thread. The result is in file order and does not depend on
+    // the thread count. Lines that cannot be parsed are skipped, and when line_errors is given they are also recorded
+    // there in file order.
+    virtual std::vector<std::tuple<float, float, Polygon>> ReadPointsAndPolygonsFromFile(
+            std::string_view filepath, size_t thread_count, std::vector<LineError>* line_errors = nullptr) = 0;
+
+    // Same as ReadPointsAndPolygonsFromFile(), but reports lines that cannot be parsed through error codes instead of
+    // exceptions, which keeps dirty inputs as fast to read as clean ones. The policy decides whether bad lines are
+    // skipped silently, skipped with a diagnostic, or end the read. Blank and comment lines are not errors, they are
+    // skipped under every policy without a diagnostic. Parsing is split over thread_count threads as
+    // above, with results and diagnostics independent of the thread count. Still throws a std::runtime_error if the
+    // file cannot be read.
+    virtual ParseResult ParsePointsAndPolygonsFromFile(std::string_view filepath, ErrorPolicy policy,
+                                                       size_t thread_count = 1) = 0;
+
+    // Called with each point and polygon of a file in turn. The polygon is reused for the next record, so a visitor
+    // that keeps it has to copy or move it out. Returning false stops the read.
+    using RecordVisitor = std::function<bool(float x, float y, Polygon& polygon)>;
+
+    // Reads a file in the format of ReadPointsAndPolygonsFromFile() one record at a time, passing each to the visitor
+    // as soon as its line is parsed rather than collecting them all. Memory use does not grow with the file: the
+    // polygon's storage is reused between records, and parsed parts of the file are released as the read goes. Lines
+    // that cannot be parsed are skipped, and recorded in line_errors when it is given. Returns the number of records
+    // passed to the visitor, and throws a std::runtime_error if the file cannot be read.
+    virtual size_t ForEachPointAndPolygonInFile(std::string_view filepath, const RecordVisitor& visitor,
+                                                std::vector<LineError>* line_errors = nullptr) = 0;
+
+    // The longest line, in bytes without its newline, that the file readers above parse, 0 meaning no limit, which is
+    // the default. A longer line is skipped like any other line that cannot be parsed, reported as
+    // ParseErrorKind::kLineTooLong, whether or not the file is compressed. The limit also bounds the memory a
+    // compressed file's reader holds for a line whose end has not been decompressed yet, which is otherwise the size
+    // of the longest line.
+    virtual size_t max_line_bytes() const noexcept = 0;
+    virtual void max_line_bytes(size_t max_line_bytes) noexcept = 0;
 };
 
 }  // namespace poly
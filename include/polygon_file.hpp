@@ -0,0 +1,94 @@
+#ifndef POLYGON_FILE_HPP_
+#define POLYGON_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <polygon_layout.hpp>
+
+namespace poly {
+
+namespace internal {
+class MappedFile;
+}  // namespace internal
+
+// A binary, columnar container for the records of a text polygon file, laid out so that it can be memory mapped and
+// used in place. All values are little endian and every section starts at an offset aligned to its element size:
+//
+//     header            PolygonFileHeader
+//     vertex offsets    uint64_t[record_count + 1], record i owns vertices [offsets[i], offsets[i + 1])
+//     point x, point y  float[record_count] each
+//     vertex x, y       float[vertex_count] each
+//
+// Opening a file only checks its header and size, the records are neither parsed nor copied.
+struct PolygonFileHeader {
+    static constexpr char kMagic[8] = {'W', 'N', 'P', 'O', 'L', 'Y', '\0', '\1'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order_mark;  // kByteOrderMark as written, catches files from a machine of the other byte order.
+    uint64_t record_count;
+    uint64_t vertex_count;
+};
+
+// Converts a file in the text format of IPolygonReader::ReadPointsAndPolygonsFromFile() into the binary format,
+// skipping lines that cannot be parsed the same way the reader does and recording them in line_errors when it is
+// given. Returns the number of records written. Throws a std::runtime_error when either file cannot be accessed.
+size_t WritePolygonFile(IPolygonReader& reader, std::string_view text_path, std::string_view binary_path,
+                        std::vector<LineError>* line_errors = nullptr);
+
+// Writes points and polygons to a binary file directly.
+void WritePolygonFile(const std::vector<std::tuple<float, float, Polygon>>& point_and_polygons,
+                      std::string_view binary_path);
+
+// A binary polygon file mapped into memory. Records are handed out as views into the mapping, which stay valid for
+// as long as the PolygonFile does.
+class PolygonFile {
+public:
+    // Maps the file. Throws a std::runtime_error when it cannot be read, is not a polygon file, or its size does not
+    // match its header. This takes constant time, the offsets table is not checked.
+    explicit PolygonFile(std::string_view path);
+    ~PolygonFile();
+
+    PolygonFile(const PolygonFile&) = delete;
+    PolygonFile& operator=(const PolygonFile&) = delete;
+
+    // Checks that the offsets table describes records within the vertex columns, throwing a std::runtime_error if it
+    // does not. Files from an untrusted source should be validated before their records are accessed.
+    void Validate() const;
+
+    // The number of records.
+    size_t size() const noexcept;
+
+    // The point and polygon of record i.
+    float point_x(size_t i) const noexcept;
+    float point_y(size_t i) const noexcept;
+    PolygonView polygon(size_t i) const noexcept;
+
+    // The columns, for processing every record at once.
+    const float* point_x_data() const noexcept;
+    const float* point_y_data() const noexcept;
+    const uint64_t* vertex_offsets() const noexcept;
+
+private:
+    std::unique_ptr<internal::MappedFile> file_;
+    std::string path_;
+    size_t record_count_ = 0;
+    const uint64_t* vertex_offsets_ = nullptr;
+    const float* point_x_ = nullptr;
+    const float* point_y_ = nullptr;
+    const float* vertex_x_ = nullptr;
+    const float* vertex_y_ = nullptr;
+};
+
+}  // namespace poly
+
+#endif
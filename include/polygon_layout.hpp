@@ -0,0 +1,130 @@
+#ifndef POLYGON_LAYOUT_HPP_
+#define POLYGON_LAYOUT_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <poly_io.hpp>
+
+namespace poly {
+
+// Layout policies for vertex coordinates. A policy maps vertex i to the positions of its x and y coordinates, either
+// in two separate arrays or in a single one, and gives the number of floats an array needs to hold count vertices.
+
+// x and y in two arrays, the layout of Polygon. Walking the edges reads from two separate regions of memory.
+struct SeparateLayout {
+    static constexpr bool kSingleArray = false;
+    static constexpr size_t XIndex(size_t i) noexcept { return i; }
+    static constexpr size_t YIndex(size_t i) noexcept { return i; }
+    static constexpr size_t ArraySize(size_t count) noexcept { return count; }
+};
+
+// Blocks of kBlockSize x coordinates each followed by the matching kBlockSize y coordinates, in one array. The last
+// block is padded. Blocks of one are plain interleaved (x, y) pairs, so an edge's coordinates share a cache line, and
+// blocks of a lane count can be loaded straight into vector registers.
+template <size_t kBlockSize>
+struct BlockedLayout {
+    static_assert(kBlockSize > 0, "blocks hold at least one vertex");
+    static constexpr bool kSingleArray = true;
+    static constexpr size_t XIndex(size_t i) noexcept { return i / kBlockSize * 2 * kBlockSize + i % kBlockSize; }
+    static constexpr size_t YIndex(size_t i) noexcept { return XIndex(i) + kBlockSize; }
+    static constexpr size_t ArraySize(size_t count) noexcept {
+        return (count + kBlockSize - 1) / kBlockSize * 2 * kBlockSize;
+    }
+};
+
+using InterleavedLayout = BlockedLayout<1>;
+using Blocked8Layout = BlockedLayout<8>;
+using Blocked16Layout = BlockedLayout<16>;
+
+// The layouts by name, for choosing one at run time.
+enum class VertexLayout {
+    kSeparate,     // SeparateLayout
+    kInterleaved,  // InterleavedLayout
+    kBlocked8,     // Blocked8Layout
+    kBlocked16,    // Blocked16Layout
+};
+
+// A read-only view of size vertices stored in a layout. Views neither own nor copy the coordinates, so they can wrap
+// a Polygon, a VertexBuffer or memory the caller manages. For single array layouts x_data() and y_data() are the same.
+template <typename Layout>
+class BasicPolygonView {
+public:
+    BasicPolygonView() = default;
+    BasicPolygonView(const float* x_data, const float* y_data, size_t size) noexcept :
+            x_data_(x_data), y_data_(y_data), size_(size) {}
+    BasicPolygonView(const float* data, size_t size) noexcept : x_data_(data), y_data_(data), size_(size) {
+        static_assert(Layout::kSingleArray, "separate layouts need an x and a y array");
+    }
+
+    size_t size() const noexcept { return size_; }
+    float x(size_t i) const noexcept { return x_data_[Layout::XIndex(i)]; }
+    float y(size_t i) const noexcept { return y_data_[Layout::YIndex(i)]; }
+    const float* x_data() const noexcept { return x_data_; }
+    const float* y_data() const noexcept { return y_data_; }
+
+private:
+    const float* x_data_ = nullptr;
+    const float* y_data_ = nullptr;
+    size_t size_ = 0;
+};
+
+using PolygonView = BasicPolygonView<SeparateLayout>;
+
+// A view of a polygon's own coordinates, without copying them.
+inline PolygonView MakeView(const Polygon& polygon) noexcept {
+    return PolygonView(polygon.x_vec_.data(), polygon.y_vec_.data(), polygon.size());
+}
+
+// Copies the vertices of a view into a Polygon, for the APIs that take one.
+template <typename Layout>
+Polygon ToPolygon(const BasicPolygonView<Layout>& view) {
+    Polygon polygon(view.size());
+    for (size_t i = 0; i < view.size(); ++i) {
+        polygon.AppendPoint(view.x(i), view.y(i));
+    }
+    return polygon;
+}
+
+// Owns the vertices of a polygon stored in a layout chosen at run time.
+class VertexBuffer {
+public:
+    VertexBuffer() = default;
+
+    // Copies the polygon's vertices into the layout. A polygon moved in with the separate layout keeps its arrays.
+    VertexBuffer(const Polygon& polygon, VertexLayout layout);
+    VertexBuffer(Polygon&& polygon, VertexLayout layout);
+
+    VertexLayout layout() const noexcept { return layout_; }
+    size_t size() const noexcept { return size_; }
+
+    // Copies the vertices back into a Polygon.
+    Polygon ToPolygon() const;
+
+    // Calls visitor with a BasicPolygonView in the buffer's layout and returns its result, so that code written
+    // against the layout policies runs on the buffer with the layout resolved once per call rather than per vertex.
+    template <typename Visitor>
+    decltype(auto) Visit(Visitor&& visitor) const {
+        switch (layout_) {
+        case VertexLayout::kInterleaved:
+            return visitor(BasicPolygonView<InterleavedLayout>(x_vec_.data(), size_));
+        case VertexLayout::kBlocked8:
+            return visitor(BasicPolygonView<Blocked8Layout>(x_vec_.data(), size_));
+        case VertexLayout::kBlocked16:
+            return visitor(BasicPolygonView<Blocked16Layout>(x_vec_.data(), size_));
+        case VertexLayout::kSeparate:
+            break;
+        }
+        return visitor(PolygonView(x_vec_.data(), y_vec_.data(), size_));
+    }
+
+private:
+    VertexLayout layout_ = VertexLayout::kSeparate;
+    size_t size_ = 0;
+    std::vector<float> x_vec_;  // Holds every coordinate in single array layouts.
+    std::vector<float> y_vec_;
+};
+
+}  // namespace poly
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef POLYGON_PACK_HPP_
+#define POLYGON_PACK_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+// A fixed list of small polygons, such as the candidates a spatial index returns for one of its cells, laid out so
+// that one point is tested against kLanes of them per instruction.
+//
+// The normalized candidates are sorted by edge count and dealt out kLanes at a time into groups. Within a group the
+// vertices are interleaved, row v holding vertex v of every polygon in the group, and shorter polygons are padded to
+// the group's longest with copies of their closing vertex. Padding edges have zero length and contribute nothing, so a
+// query walks each group's rows once and evaluates every lane's edge together, giving the same winding numbers as a
+// scan of each polygon.
+class PolygonPack {
+public:
+    static constexpr size_t kLanes = 8;
+
+    // Normalizes the polygons of the set named by the candidate indices and packs them. Returns nullptr, with the
+    // algorithm's error_message() set, when one of them cannot be normalized.
+    [[nodiscard]] static std::unique_ptr<PolygonPack> Build(const poly::PolygonSet& polygons,
+                                                            const std::vector<size_t>& candidates,
+                                                            IWindingNumberAlgorithm& algorithm);
+
+    // Writes the winding number of the point with respect to the i-th candidate to winding_numbers[i], for every
+    // candidate the pack was built from.
+    void CalculateWindingNumbers2D(float x, float y, int* winding_numbers) const;
+
+    // Same as above, returning the winding numbers in candidate order.
+    std::vector<int> CalculateWindingNumbers2D(float x, float y) const;
+
+    // The number of candidates in the pack.
+    size_t size() const noexcept;
+
+    // The fraction of the pack's edge slots taken up by padding, in [0, 1).
+    float padding_fraction() const noexcept;
+
+private:
+    struct Group {
+        size_t first_row;  // Rows first_row .. first_row + row_count of x_vec_ and y_vec_.
+        size_t row_count;
+    };
+
+    PolygonPack() = default;
+
+    std::vector<Group> groups_;
+    std::vector<float> x_vec_;  // Rows of kLanes vertices.
+    std::vector<float> y_vec_;
+    std::vector<size_t> lane_candidates_;  // Candidate position held by each lane of each group, kNoCandidate if none.
+    size_t size_ = 0;
+    size_t edge_count_ = 0;  // Real edges over all candidates.
+};
+
+}  // namespace winding_number
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef PREPARED_HPP_
+#define PREPARED_HPP_
+
+#include <cstddef>
+#include <optional>  // A C++17 capable compiler is assumed here.
+
+#include <poly_io.hpp>
+
+namespace winding_number {
+
+// The result of normalizing a polygon: a closed polygon in which no two consecutive vertices are within tolerance of
+// each other and no vertex sits in the middle of a straight run. Querying the normalized polygon gives the same winding
+// number as querying the original one (up to tolerance), but every edge it has is worth evaluating.
+struct NormalizedPolygon {
+    poly::Polygon polygon;
+
+    // Vertex counts for the normalization pass. All counts include the closing vertex, so
+    // input_vertex_count == polygon.size() + duplicate_vertices_removed + collinear_vertices_removed.
+    size_t input_vertex_count = 0;
+    size_t duplicate_vertices_removed = 0;
+    size_t collinear_vertices_removed = 0;
+
+    // The fraction of the input vertices that normalization removed, in [0, 1].
+    float vertex_reduction() const noexcept;
+};
+
+// The strategies available for answering repeated queries against a single polygon.
+enum class Engine {
+    kAutomatic,         // Let IWindingNumberAlgorithm::Prepare() pick one based on the polygon.
+    kScan,              // A linear scan over the normalized edges, O(n) per query.
+    kMonotoneChain,     // Binary searches within x-monotone chains, see MonotoneChainPolygon.
+    kEdgeIntervalTree,  // Visits only edges whose x-extent holds the point, see EdgeIntervalTreePolygon.
+    kQuadtree,          // Adaptive quadtree with pre-classified cells, see QuadtreePolygon. Never picked
+                        // automatically, its build cost only pays off under heavy query load.
+    kConvex,            // Binary searches the two x-monotone chains of a convex polygon, see ConvexPolygon.
+    kRectilinear,       // Prefix sums over the horizontal edges of axis-aligned polygons, see RectilinearPolygon.
+    kStar,              // Binary searches the angular wedges around a kernel point, see StarPolygon.
+    kHullFilter,        // Conservative inner and outer hulls in front of a scan, see HullFilteredPolygon. Never picked
+                        // automatically, it only pays off when most queries fall clear of the boundary.
+    kPointBatch,        // A scan that evaluates each edge for a lane group of points at once, see PointBatchPolygon.
+                        // Picked automatically only for batches that are large against the polygon's edge count.
+};
+
+// A polygon that has been validated and normalized once up front, so that it can be queried many times without
+// re-checking closure or filtering degenerate edges on every call.
+class IPreparedPolygon {
+public:
+    virtual ~IPreparedPolygon() = default;
+
+    // Returns the winding number of a 2D point with respect to the prepared polygon, with the same semantics as
+    // IWindingNumberAlgorithm::CalculateWindingNumber2D().
+    virtual int CalculateWindingNumber2D(float x, float y) const = 0;
+
+    // Calculates the winding numbers of count points at once, given as separate arrays of x and y coordinates. Engines
+    // with a vectorized query override this, the default answers one point at a time.
+    virtual void CalculateWindingNumbers2D(const float* x, const float* y, size_t count, int* winding_numbers) const;
+
+    // The engine answering queries for this polygon.
+    virtual Engine engine() const noexcept = 0;
+
+    // Whether the polygon has no self-intersections, see IsSimple(). IWindingNumberAlgorithm::Prepare() only checks
+    // when it picks the engine itself or prepares a convex or star engine. This is std::nullopt for other engines and
+    // for engines constructed directly.
+    std::optional<bool> simple() const noexcept;
+
+private:
+    friend class IWindingNumberAlgorithm;
+
+    std::optional<bool> simple_;
+};
+
+}  // namespace winding_number
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef QUADTREE_HPP_
+#define QUADTREE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// An engine built on an adaptive quadtree over the polygon's bounding box. Cells are only split where they hold more
+// than a handful of edges, so detailed stretches of boundary get small cells while long straight stretches and open
+// space stay coarse.
+//
+// Every leaf is either a boundary leaf, listing the edges that pass through it, or an edge-free leaf whose winding
+// number is computed once at build time (zero for leaves outside the polygon). Queries in edge-free leaves are answered
+// by the descent alone. Queries in boundary leaves walk up the column of leaves above the point to the first edge-free
+// leaf, and correct its winding number with the edges passed on the way.
+class QuadtreePolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize().
+    explicit QuadtreePolygon(const poly::Polygon& polygon, size_t max_leaf_edges = 8, size_t max_depth = 16);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    Engine engine() const noexcept override;
+
+    // Shape of the tree, to judge how well it fits the polygon.
+    size_t depth() const noexcept;
+    size_t node_count() const noexcept;
+    size_t inside_leaf_count() const noexcept;
+    size_t outside_leaf_count() const noexcept;
+    size_t boundary_leaf_count() const noexcept;
+
+private:
+    struct Edge {
+        float ax, ay, bx, by;
+    };
+
+    struct Node {
+        float min_x, min_y, max_x, max_y;  // The cell covers [min_x, max_x) x [min_y, max_y).
+        int32_t first_child;               // Index of the first of four children, or -1 for a leaf.
+        int32_t winding_number;            // Edge-free leaves only.
+        uint32_t first_edge;               // Boundary leaves only, a range of edge_indices_.
+        uint32_t edge_count;
+    };
+
+    void Build(size_t node, std::vector<uint32_t>& edges, size_t depth, const IPreparedPolygon& classifier);
+    bool Touches(const Edge& edge, const Node& node) const;
+    const Node& Locate(float x, float y) const;
+
+    size_t max_leaf_edges_;
+    size_t max_depth_;
+    float margin_;  // Cells are widened by this much when deciding which edges pass through them.
+
+    std::vector<Edge> edges_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> edge_indices_;
+
+    size_t depth_ = 0;
+    size_t inside_leaf_count_ = 0;
+    size_t outside_leaf_count_ = 0;
+    size_t boundary_leaf_count_ = 0;
+};
+
+}  // namespace winding_number
+
+#endif
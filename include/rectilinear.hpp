@@ -0,0 +1,64 @@
+#ifndef RECTILINEAR_HPP_
+#define RECTILINEAR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// An engine for rectilinear polygons, whose edges are all exactly horizontal or vertical, such as floor plans and
+// polygons traced from rasters.
+//
+// A vertical ray only crosses horizontal edges, and whether it does only depends on which slab of x coordinates between
+// consecutive vertices holds the point. Each slab keeps the horizontal edges spanning it sorted by y, with running sums
+// of their contributions from the top down, so a query is a binary search for the slab and two for the point's height
+// -- no cross products. Vertical edges only matter for points on them, and are kept sorted by x to find those.
+//
+// Slabs can hold O(n) edges each, so the engine takes up to O(n^2) memory. CountSlabEntries() tells how much a polygon
+// needs before building it.
+class RectilinearPolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize() and to be rectilinear.
+    explicit RectilinearPolygon(const poly::Polygon& polygon);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    Engine engine() const noexcept override;
+
+    size_t slab_count() const noexcept;
+
+    // Whether every edge of the polygon is exactly horizontal or vertical.
+    static bool IsRectilinear(const poly::Polygon& polygon);
+
+    // The number of (slab, edge) pairs the engine would store for a rectilinear polygon.
+    static size_t CountSlabEntries(const poly::Polygon& polygon);
+
+private:
+    struct VerticalEdge {
+        float x, lo, hi;  // The edge's x and its extent from EdgeXExtent().
+        float ay, by;
+    };
+
+    int VerticalContribution(float x, float y) const;
+
+    // Slab j covers [slab_x_[j], slab_x_[j + 1]), and the heights of the edges spanning it are entry_y_[slab_first_[j],
+    // slab_first_[j + 1]) in increasing order. The sums of the leftward and the rightward edges from entry i of slab j
+    // to the slab's top are at index i + j, followed by a zero for the empty sum past the top.
+    std::vector<float> slab_x_;
+    std::vector<uint32_t> slab_first_;
+    std::vector<float> entry_y_;
+    std::vector<int32_t> leftward_suffix_;
+    std::vector<int32_t> rightward_suffix_;
+
+    // Upward vertical edges sorted by the low end of their extent, with the running maximum of the high end.
+    std::vector<VerticalEdge> vertical_edges_;
+    std::vector<float> vertical_lo_;
+    std::vector<float> vertical_reach_;
+};
+
+}  // namespace winding_number
+
+#endif
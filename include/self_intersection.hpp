@@ -0,0 +1,25 @@
+#ifndef SELF_INTERSECTION_HPP_
+#define SELF_INTERSECTION_HPP_
+
+#include <cstddef>
+#include <optional>  // A C++17 capable compiler is assumed here.
+#include <utility>
+
+#include <poly_io.hpp>
+
+namespace winding_number {
+
+// Finds a pair of edges of a closed polygon that intersect, where edge i runs from vertex i to vertex i + 1. Edges that
+// follow each other may share their common vertex, but nothing more, and no other pair of edges may touch at all.
+// Returns std::nullopt when the polygon is simple.
+//
+// This is a plane sweep in the style of Bentley and Ottmann which stops at the first intersection found, so it runs in
+// O(n log n) for n edges. Orientation tests are evaluated in double precision, which is exact for most float input.
+std::optional<std::pair<size_t, size_t>> FindSelfIntersection(const poly::Polygon& polygon);
+
+// Whether the closed polygon has no self-intersections, see FindSelfIntersection().
+bool IsSimple(const poly::Polygon& polygon);
+
+}  // namespace winding_number
+
+#endif
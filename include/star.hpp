@@ -0,0 +1,76 @@
+#ifndef STAR_HPP_
+#define STAR_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <optional>  // A C++17 capable compiler is assumed here.
+#include <utility>
+#include <vector>
+
+#include <edge_interval_tree.hpp>
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+namespace winding_number {
+
+// An engine for star-shaped polygons: polygons with a kernel point from which the whole boundary is visible, like the
+// sector shaped coverage areas of a radio mast. Vertices are sorted by their angle around the kernel point, so a query
+// binary searches for the wedge holding the point and tests the single edge closing that wedge, in O(log n).
+//
+// The wedge test is exact geometry, while SimpleWindingNumberAlgorithm decides points on and right next to the
+// boundary with float arithmetic. Points within rounding distance of an edge are therefore passed on to an edge
+// interval tree, so that answers match a scan everywhere.
+class StarPolygon : public IPreparedPolygon {
+public:
+    // The polygon is expected to be the output of IWindingNumberAlgorithm::Normalize(), and the kernel point to be
+    // strictly inside its kernel, as found by FindKernelPoint().
+    StarPolygon(const poly::Polygon& polygon, std::pair<float, float> kernel_point);
+
+    int CalculateWindingNumber2D(float x, float y) const override;
+    Engine engine() const noexcept override;
+
+    std::pair<float, float> kernel_point() const noexcept;
+
+    // Returns a point strictly inside the kernel of a normalized polygon, or std::nullopt when the polygon is not star
+    // shaped. Clips the polygon's bounding box with the inner half-plane of every edge, which takes O(n * k) for a
+    // kernel with k corners. Gives up, also returning std::nullopt, once the kernel has more than max_kernel_corners
+    // corners, which bounds the search to O(n * max_kernel_corners).
+    static std::optional<std::pair<float, float>> FindKernelPoint(
+            const poly::Polygon& polygon, size_t max_kernel_corners = std::numeric_limits<size_t>::max());
+
+    // Whether every edge of the polygon has the point strictly on its inner side and the polygon goes around the point
+    // exactly once.
+    static bool IsKernelPoint(const poly::Polygon& polygon, std::pair<float, float> point);
+
+private:
+    struct Box {
+        float min_x, min_y, max_x, max_y;
+    };
+
+    bool InVerticalBox(float x, float y) const;
+    bool NearBoundary(double dx, double dy, size_t wedge) const;
+    double EdgeDistance(size_t edge, double dx, double dy) const;
+
+    double center_x_, center_y_;
+
+    // Vertices relative to the kernel point in counter-clockwise order and closed, with their angles around it
+    // increasing from the first.
+    std::vector<double> angles_;
+    std::vector<double> x_vec_;
+    std::vector<double> y_vec_;
+
+    // 1 for a counter-clockwise polygon, -1 for a clockwise one.
+    int inside_winding_number_;
+
+    // Points this close to an edge, or inside one of the boxes in which upward near-vertical edges affect the points
+    // beside them, are passed on to the fallback. The boxes are sorted by their low x and searched as an implicit
+    // interval tree, like the edges of an EdgeIntervalTreePolygon.
+    double margin_;
+    std::vector<Box> vertical_boxes_;
+    std::vector<float> vertical_boxes_subtree_max_x_;
+    EdgeIntervalTreePolygon fallback_;
+};
+
+}  // namespace winding_number
+
+#endif
@@ -1,12 +1,15 @@
 #ifndef WINDING_HPP_
 #define WINDING_HPP_
 
+#include <cstddef>
 #include <memory>
 #include <optional>  // A C++17 capable compiler is assumed here.
 #include <string>
 #include <vector>
 
 #include <poly_io.hpp>
+#include <polygon_layout.hpp>
+#include <prepared.hpp>
 
 namespace winding_number {
 
@@ -31,10 +34,28 @@ public:
     // returns std::nullopt.
     virtual std::optional<int> CalculateWindingNumber2D(float x, float y, poly::Polygon polygon) = 0;
 
+    // Collapses vertices that are within tolerance() of their predecessor and merges straight runs, returning the
+    // compact polygon and how much it shrank. Returns std::nullopt, and sets error_message(), if the polygon is not
+    // closed or does not have enough geometry left to enclose anything.
+    std::optional<NormalizedPolygon> Normalize(const poly::Polygon& polygon);
+
+    // Normalizes the polygon and builds the requested engine over it for repeated queries. Returns nullptr, and sets
+    // error_message(), when the polygon cannot be normalized.
+    //
+    // batch_size is the number of points the caller expects to pass to each CalculateWindingNumbers2D() call on the
+    // result, automatic selection takes it into account when it is large against the polygon's edge count.
+    std::unique_ptr<IPreparedPolygon> Prepare(const poly::Polygon& polygon, Engine engine = Engine::kAutomatic,
+                                              size_t batch_size = 1);
+
     // Getters and setters for an initial set of parameters and results.
     float tolerance() const noexcept;
     void tolerance(float tolerance) noexcept;
 
+    // The layout that Prepare() stores vertices in for the engines that stream over them, the scan and point batch
+    // engines. Engines with an index build their own structures and ignore it.
+    poly::VertexLayout vertex_layout() const noexcept;
+    void vertex_layout(poly::VertexLayout vertex_layout) noexcept;
+
     std::string error_message() const noexcept;
 
 protected:
@@ -45,6 +66,8 @@ private:
     // dimensions, then they are considered the same point.
     float tolerance_ = 0.f;
 
+    poly::VertexLayout vertex_layout_ = poly::VertexLayout::kSeparate;
+
     // An error message describing what, if anything, went wrong with the most recent call to CalculateWindingNumber().
     std::string error_message_;
 };
@@ -0,0 +1,59 @@
+#include "cache_internal.hpp"
+
+#include <fstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace winding_number {
+namespace internal {
+namespace {
+
+constexpr size_t kDefaultL1DataSize = 32 * 1024;
+constexpr size_t kDefaultL2Size = 256 * 1024;
+
+// Reads a size such as "48K" from the Linux sysfs cache description of the first CPU, 0 when there is none.
+size_t ReadSysfsCacheSize(int level, const std::string& type) {
+    for (int index = 0; index < 8; ++index) {
+        std::string directory = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+        std::ifstream level_file(directory + "level"), type_file(directory + "type"), size_file(directory + "size");
+        int cache_level = 0;
+        std::string cache_type, size;
+        if (!(level_file >> cache_level) || !(type_file >> cache_type) || !(size_file >> size)) {
+            break;
+        }
+        if (cache_level != level || (cache_type != type && cache_type != "Unified")) continue;
+        size_t bytes = 0;
+        size_t i = 0;
+        for (; i < size.size() && '0' <= size[i] && size[i] <= '9'; ++i) {
+            bytes = bytes * 10 + size_t(size[i] - '0');
+        }
+        if (i < size.size() && size[i] == 'K') bytes *= 1024;
+        if (i < size.size() && size[i] == 'M') bytes *= 1024 * 1024;
+        return bytes;
+    }
+    return 0;
+}
+
+size_t QueryCacheSize(int level, size_t fallback) {
+    long bytes = 0;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+    bytes = sysconf(level == 1 ? _SC_LEVEL1_DCACHE_SIZE : _SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (bytes <= 0) {
+        bytes = long(ReadSysfsCacheSize(level, "Data"));
+    }
+    return bytes > 0 ? size_t(bytes) : fallback;
+}
+
+}  // namespace
+
+const CacheSizes& DetectCacheSizes() {
+    static const CacheSizes sizes = {QueryCacheSize(1, kDefaultL1DataSize), QueryCacheSize(2, kDefaultL2Size)};
+    return sizes;
+}
+
+}  // namespace internal
+}  // namespace winding_number
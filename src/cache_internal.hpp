@@ -0,0 +1,22 @@
+#ifndef CACHE_INTERNAL_HPP_
+#define CACHE_INTERNAL_HPP_
+
+#include <cstddef>
+
+namespace winding_number {
+namespace internal {
+
+// Per-core data cache sizes in bytes, used to size the tiles of the batch kernels.
+struct CacheSizes {
+    size_t l1_data;
+    size_t l2;
+};
+
+// Queries the cache sizes the first time it is called and returns the same result afterwards. Falls back to common
+// x86-64 sizes when the platform does not report them.
+const CacheSizes& DetectCacheSizes();
+
+}  // namespace internal
+}  // namespace winding_number
+
+#endif
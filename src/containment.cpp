@@ -0,0 +1,154 @@
+#include <containment.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::InteriorPoint;
+
+double Area(const poly::Polygon& polygon) {
+    double twice_area = 0;
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        twice_area += double(polygon.x_vec_[i]) * polygon.y_vec_[i + 1] -  //
+                      double(polygon.x_vec_[i + 1]) * polygon.y_vec_[i];
+    }
+    return std::abs(twice_area) / 2;
+}
+
+}  // namespace
+
+std::unique_ptr<ContainmentHierarchy> ContainmentHierarchy::Build(const poly::PolygonSet& polygons,
+                                                                  IWindingNumberAlgorithm& algorithm) {
+    std::unique_ptr<ContainmentHierarchy> hierarchy(new ContainmentHierarchy());
+    size_t count = polygons.size();
+    std::vector<std::pair<float, float>> interior_points;
+    std::vector<double> areas;
+    hierarchy->nodes_.reserve(count);
+    interior_points.reserve(count);
+    areas.reserve(count);
+    for (const auto& polygon : polygons.polygons_) {
+        auto prepared = algorithm.Prepare(polygon);
+        if (!prepared) {
+            return nullptr;
+        }
+        Node node = {};
+        node.min_x = *std::min_element(polygon.x_vec_.begin(), polygon.x_vec_.end());
+        node.max_x = *std::max_element(polygon.x_vec_.begin(), polygon.x_vec_.end());
+        node.min_y = *std::min_element(polygon.y_vec_.begin(), polygon.y_vec_.end());
+        node.max_y = *std::max_element(polygon.y_vec_.begin(), polygon.y_vec_.end());
+        node.parent = kNoParent;
+        interior_points.push_back(InteriorPoint(polygon, *prepared));
+        areas.push_back(Area(polygon));
+        node.prepared = std::move(prepared);
+        hierarchy->nodes_.push_back(std::move(node));
+    }
+
+    // Insert the polygons from the largest down, so that every polygon's container is already in the tree when it
+    // arrives, and find its parent with the same descent that queries use. The last list holds the roots.
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&areas](size_t lhs, size_t rhs) { return areas[lhs] > areas[rhs]; });
+    std::vector<std::vector<uint32_t>> children(count + 1);
+    std::vector<size_t> depths(count, 0);
+    for (size_t polygon : order) {
+        auto [x, y] = interior_points[polygon];
+        size_t current = count;
+        bool descended = true;
+        while (descended) {
+            descended = false;
+            for (uint32_t child : children[current]) {
+                if (hierarchy->Contains(hierarchy->nodes_[child], x, y)) {
+                    current = child;
+                    descended = true;
+                    break;
+                }
+            }
+        }
+        children[current].push_back(uint32_t(polygon));
+        if (current != count) {
+            hierarchy->nodes_[polygon].parent = current;
+            depths[polygon] = depths[current] + 1;
+        }
+        hierarchy->depth_ = std::max(hierarchy->depth_, depths[polygon] + 1);
+    }
+
+    for (size_t i = 0; i <= count; ++i) {
+        uint32_t first = uint32_t(hierarchy->child_indices_.size());
+        hierarchy->child_indices_.insert(hierarchy->child_indices_.end(), children[i].begin(), children[i].end());
+        if (i < count) {
+            hierarchy->nodes_[i].first_child = first;
+            hierarchy->nodes_[i].child_count = uint32_t(children[i].size());
+        } else {
+            hierarchy->first_root_ = first;
+            hierarchy->root_count_ = uint32_t(children[i].size());
+        }
+    }
+    return hierarchy;
+}
+
+bool ContainmentHierarchy::Contains(const Node& node, float x, float y) const {
+    if (x < node.min_x || x > node.max_x || y < node.min_y || y > node.max_y) {
+        return false;
+    }
+    return node.prepared->CalculateWindingNumber2D(x, y) != 0;
+}
+
+std::vector<size_t> ContainmentHierarchy::ContainingPolygons(float x, float y) const {
+    std::vector<size_t> chain;
+    ContainingPolygons(x, y, chain);
+    return chain;
+}
+
+void ContainmentHierarchy::ContainingPolygons(float x, float y, std::vector<size_t>& chain) const {
+    chain.clear();
+    uint32_t first = first_root_;
+    uint32_t count = root_count_;
+    bool descended = true;
+    while (descended) {
+        descended = false;
+        for (uint32_t i = first; i < first + count; ++i) {
+            uint32_t candidate = child_indices_[i];
+            const Node& node = nodes_[candidate];
+            if (Contains(node, x, y)) {
+                // Only the children of a containing polygon can contain the point as well.
+                chain.push_back(candidate);
+                first = node.first_child;
+                count = node.child_count;
+                descended = true;
+                break;
+            }
+        }
+    }
+}
+
+size_t ContainmentHierarchy::size() const noexcept {
+    return nodes_.size();
+}
+
+size_t ContainmentHierarchy::parent(size_t polygon) const noexcept {
+    return nodes_[polygon].parent;
+}
+
+std::vector<size_t> ContainmentHierarchy::children(size_t polygon) const {
+    const Node& node = nodes_[polygon];
+    return std::vector<size_t>(child_indices_.begin() + node.first_child,
+                               child_indices_.begin() + node.first_child + node.child_count);
+}
+
+std::vector<size_t> ContainmentHierarchy::roots() const {
+    return std::vector<size_t>(child_indices_.begin() + first_root_,
+                               child_indices_.begin() + first_root_ + root_count_);
+}
+
+size_t ContainmentHierarchy::depth() const noexcept {
+    return depth_;
+}
+
+}  // namespace winding_number
@@ -0,0 +1,216 @@
+#include <convex.hpp>
+
+#include <algorithm>
+
+#include "simd_internal.hpp"
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeContribution;
+using internal::EdgeXExtent;
+using internal::FuzzyEquals;
+using internal::Point;
+
+// The vertices with the smallest and largest x coordinate, the first of each when there are ties.
+std::pair<size_t, size_t> Extremes(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    auto last = x_vec.end() - 1;
+    auto [leftmost, rightmost] = std::minmax_element(x_vec.begin(), last);
+    // minmax_element() returns the last of several largest elements, take the first for symmetry.
+    rightmost = std::find(x_vec.begin(), last, *rightmost);
+    return {size_t(leftmost - x_vec.begin()), size_t(rightmost - x_vec.begin())};
+}
+
+// Whether x never decreases (or never increases) walking the polygon from vertex first to vertex last.
+bool MonotoneWalk(const std::vector<float>& x_vec, size_t first, size_t last, bool increasing) {
+    size_t vertex_count = x_vec.size() - 1;
+    for (size_t vertex = first; vertex != last; vertex = (vertex + 1) % vertex_count) {
+        float from = x_vec[vertex], to = x_vec[(vertex + 1) % vertex_count];
+        if (increasing ? to < from : to > from) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(WINDING_NUMBER_SIMD)
+using internal::Abs;
+using internal::AddEdgeContribution;
+using internal::Broadcast;
+using internal::FloatLanes;
+using internal::Gather;
+using internal::IntLanes;
+using internal::Select;
+
+// The lane version of ConvexPolygon::ChainContribution(), adding to winding_numbers. Runs the binary search
+// branch-free so that every lane takes the same steps.
+void AddChainContribution(const std::vector<float>& x_vec, const std::vector<float>& y_vec, bool reversed,
+                          const FloatLanes& px, const FloatLanes& py, IntLanes& winding_numbers) {
+    size_t vertex_count = x_vec.size();
+    IntLanes lower = {};
+    FloatLanes probe_x;
+    for (size_t remaining = vertex_count; remaining > 1;) {
+        size_t half = remaining / 2;
+        IntLanes probe = lower + int32_t(half);
+        Gather(x_vec.data(), probe, probe_x);
+        Select(probe_x <= px, probe, lower, lower);
+        remaining -= half;
+    }
+    FloatLanes left_x, left_y, right_x, right_y, width;
+    Gather(x_vec.data(), lower, left_x);
+    IntLanes valid = (left_x <= px) & (lower < int32_t(vertex_count) - 1);
+    IntLanes upper;
+    Select(valid, lower + 1, lower, upper);
+    Gather(y_vec.data(), lower, left_y);
+    Gather(x_vec.data(), upper, right_x);
+    Gather(y_vec.data(), upper, right_y);
+    Abs(left_x - right_x, width);
+    valid &= width > 1e-6f;
+    IntLanes contribution = {};
+    if (reversed) {
+        AddEdgeContribution(right_x, right_y, left_x, left_y, px, py, contribution);
+    } else {
+        AddEdgeContribution(left_x, left_y, right_x, right_y, px, py, contribution);
+    }
+    winding_numbers += valid & contribution;
+}
+#endif
+
+}  // namespace
+
+ConvexPolygon::ConvexPolygon(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    size_t vertex_count = polygon.size() - 1;
+    auto [leftmost, rightmost] = Extremes(polygon);
+
+    // The polygon walks from its leftmost vertex to its rightmost one along the first chain, and back along the second.
+    const size_t ends[2][2] = {{leftmost, rightmost}, {rightmost, leftmost}};
+    for (int i = 0; i < 2; ++i) {
+        Chain& chain = chains_[i];
+        chain.reversed = i == 1;
+        for (size_t vertex = ends[i][0];; vertex = (vertex + 1) % vertex_count) {
+            chain.x_vec.push_back(x_vec[vertex]);
+            chain.y_vec.push_back(y_vec[vertex]);
+            if (vertex == ends[i][1]) break;
+        }
+        if (chain.reversed) {
+            std::reverse(chain.x_vec.begin(), chain.x_vec.end());
+            std::reverse(chain.y_vec.begin(), chain.y_vec.end());
+        }
+    }
+
+    double twice_area = 0;
+    for (size_t i = 0; i < vertex_count; ++i) {
+        twice_area += double(x_vec[i]) * y_vec[i + 1] - double(x_vec[i + 1]) * y_vec[i];
+        if (FuzzyEquals(x_vec[i], x_vec[i + 1])) {
+            VerticalEdge edge = {x_vec[i], y_vec[i], x_vec[i + 1], y_vec[i + 1], 0.f, 0.f};
+            EdgeXExtent({edge.ax, edge.ay}, {edge.bx, edge.by}, edge.lo, edge.hi);
+            vertical_edges_.push_back(edge);
+        }
+    }
+    orientation_ = (twice_area > 0) - (twice_area < 0);
+}
+
+int ConvexPolygon::ChainContribution(const Chain& chain, float x, float y) const {
+    // Only the edge with a.x <= p.x < b.x (in increasing x order) can cross the point's vertical ray.
+    size_t upper = std::upper_bound(chain.x_vec.begin(), chain.x_vec.end(), x) - chain.x_vec.begin();
+    if (upper == 0 || upper == chain.x_vec.size()) {
+        return 0;
+    }
+    Point left = {chain.x_vec[upper - 1], chain.y_vec[upper - 1]};
+    Point right = {chain.x_vec[upper], chain.y_vec[upper]};
+    if (FuzzyEquals(left.x, right.x)) {
+        return 0;  // Counted with the vertical edges.
+    }
+    return chain.reversed ? EdgeContribution(right, left, {x, y}) : EdgeContribution(left, right, {x, y});
+}
+
+int ConvexPolygon::CalculateWindingNumber2D(float x, float y) const {
+    int winding_number = ChainContribution(chains_[0], x, y) + ChainContribution(chains_[1], x, y);
+    for (const auto& edge : vertical_edges_) {
+        if (edge.lo <= x && x <= edge.hi) {
+            winding_number += EdgeContribution({edge.ax, edge.ay}, {edge.bx, edge.by}, {x, y});
+        }
+    }
+    return winding_number;
+}
+
+void ConvexPolygon::CalculateWindingNumbers2D(const float* x, const float* y, size_t count,
+                                              int* winding_numbers) const {
+    size_t i = 0;
+#if defined(WINDING_NUMBER_SIMD)
+    for (; i + internal::kLanes <= count; i += internal::kLanes) {
+        FloatLanes px, py;
+        internal::Load(x + i, px);
+        internal::Load(y + i, py);
+        IntLanes sum = {};
+        AddChainContribution(chains_[0].x_vec, chains_[0].y_vec, chains_[0].reversed, px, py, sum);
+        AddChainContribution(chains_[1].x_vec, chains_[1].y_vec, chains_[1].reversed, px, py, sum);
+        for (const auto& edge : vertical_edges_) {
+            IntLanes near = (px >= edge.lo) & (px <= edge.hi);
+            if (internal::Any(near)) {
+                FloatLanes ax, ay, bx, by;
+                Broadcast(edge.ax, ax);
+                Broadcast(edge.ay, ay);
+                Broadcast(edge.bx, bx);
+                Broadcast(edge.by, by);
+                IntLanes contribution = {};
+                AddEdgeContribution(ax, ay, bx, by, px, py, contribution);
+                sum += near & contribution;
+            }
+        }
+        internal::Store(sum, winding_numbers + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        winding_numbers[i] = CalculateWindingNumber2D(x[i], y[i]);
+    }
+}
+
+Engine ConvexPolygon::engine() const noexcept {
+    return Engine::kConvex;
+}
+
+int ConvexPolygon::orientation() const noexcept {
+    return orientation_;
+}
+
+bool ConvexPolygon::IsConvex(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    if (polygon.size() < 4) {
+        return false;
+    }
+    size_t vertex_count = polygon.size() - 1;
+
+    // Every turn has to go the same way, and the edges may only change between heading left and right twice. A
+    // polygon that turns consistently but winds around several times, like a pentagram, changes heading more often.
+    bool left_turn = false, right_turn = false;
+    size_t heading_changes = 0;
+    int previous_heading = 0;
+    for (size_t i = 0; i <= vertex_count; ++i) {
+        size_t vertex = i % vertex_count;
+        size_t next = (i + 1) % vertex_count;
+        size_t previous = (i + vertex_count - 1) % vertex_count;
+        double turn = (double(x_vec[vertex]) - x_vec[previous]) * (double(y_vec[next]) - y_vec[vertex]) -
+                      (double(y_vec[vertex]) - y_vec[previous]) * (double(x_vec[next]) - x_vec[vertex]);
+        left_turn |= turn > 0;
+        right_turn |= turn < 0;
+        int heading = (x_vec[next] > x_vec[vertex]) - (x_vec[next] < x_vec[vertex]);
+        if (heading != 0) {
+            // The first edge is visited twice, so that the change back to it is counted.
+            heading_changes += previous_heading != 0 && heading != previous_heading;
+            previous_heading = heading;
+        }
+    }
+    if ((left_turn && right_turn) || heading_changes > 2) {
+        return false;
+    }
+    auto [leftmost, rightmost] = Extremes(polygon);
+    return MonotoneWalk(x_vec, leftmost, rightmost, true) && MonotoneWalk(x_vec, rightmost, leftmost, false);
+}
+
+}  // namespace winding_number
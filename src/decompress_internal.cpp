@@ -0,0 +1,272 @@
+#include "decompress_internal.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(WINDING_NUMBER_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(WINDING_NUMBER_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace poly {
+namespace internal {
+namespace {
+
+    // Blocks are handed to the reader once they hold this many bytes, which is small enough for the first records to
+    // reach the parser quickly and large enough for the hand-over to cost nothing next to parsing.
+    constexpr size_t kBlockBytes = size_t(1) << 18;
+
+    // How many blocks the decompressing thread may get ahead of the reader.
+    constexpr size_t kMaxReadyBlocks = 4;
+
+    // The decompressors write into a buffer of this size before the output is appended to a block.
+    constexpr size_t kChunkBytes = size_t(1) << 16;
+
+    // Consumed compressed input is handed back to the kernel every this many bytes.
+    constexpr size_t kReleaseInterval = size_t(1) << 26;
+
+#if defined(WINDING_NUMBER_HAVE_ZLIB)
+    // Calls write(data, size, consumed) with each piece of the decompressed input, consumed being how many bytes of the
+    // input have been read so far, until write returns false. Reads concatenated gzip members as one, like gunzip.
+    template <typename Write>
+    void InflateGzip(std::string_view input, Write&& write) {
+        z_stream stream = {};
+        // 16 asks for a gzip header and trailer around the deflate data.
+        if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+            throw std::runtime_error("Failed to initialize gzip decompression.");
+        }
+        struct End {
+            z_stream& stream;
+            ~End() { inflateEnd(&stream); }
+        } end{stream};
+
+        char chunk[kChunkBytes];
+        size_t fed = 0;
+        while (true) {
+            // avail_in is 32 bits wide, so large files are fed in pieces.
+            if (stream.avail_in == 0 && fed < input.size()) {
+                size_t size = std::min<size_t>(input.size() - fed, size_t(1) << 30);
+                stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data() + fed));
+                stream.avail_in = uInt(size);
+                fed += size;
+            }
+            stream.next_out = reinterpret_cast<Bytef*>(chunk);
+            stream.avail_out = uInt(kChunkBytes);
+            int status = inflate(&stream, Z_NO_FLUSH);
+            if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+                throw std::runtime_error(std::string("Corrupt gzip input: ") + (stream.msg ? stream.msg : "unknown"));
+            }
+            bool input_exhausted = stream.avail_in == 0 && fed == input.size();
+            if (!write(chunk, kChunkBytes - stream.avail_out, fed - stream.avail_in)) {
+                return;
+            }
+            if (status == Z_STREAM_END) {
+                if (input_exhausted) {
+                    return;
+                }
+                inflateReset(&stream);
+            } else if (input_exhausted && stream.avail_out != 0) {
+                throw std::runtime_error("Truncated gzip input.");
+            }
+        }
+    }
+#endif
+
+#if defined(WINDING_NUMBER_HAVE_ZSTD)
+    // The zstd counterpart of InflateGzip(). Reads concatenated frames as one, like zstd -d.
+    template <typename Write>
+    void DecompressZstd(std::string_view input, Write&& write) {
+        ZSTD_DStream* stream = ZSTD_createDStream();
+        if (!stream || ZSTD_isError(ZSTD_initDStream(stream))) {
+            ZSTD_freeDStream(stream);
+            throw std::runtime_error("Failed to initialize zstd decompression.");
+        }
+        struct Free {
+            ZSTD_DStream* stream;
+            ~Free() { ZSTD_freeDStream(stream); }
+        } free_stream{stream};
+
+        char chunk[kChunkBytes];
+        ZSTD_inBuffer in = {input.data(), input.size(), 0};
+        size_t remaining = 0;  // Non-zero while a frame is incomplete.
+        bool output_full = false;
+        while (in.pos < in.size || output_full) {
+            ZSTD_outBuffer out = {chunk, kChunkBytes, 0};
+            remaining = ZSTD_decompressStream(stream, &out, &in);
+            if (ZSTD_isError(remaining)) {
+                throw std::runtime_error(std::string("Corrupt zstd input: ") + ZSTD_getErrorName(remaining));
+            }
+            if (!write(chunk, out.pos, in.pos)) {
+                return;
+            }
+            output_full = out.pos == out.size;
+        }
+        if (remaining != 0) {
+            throw std::runtime_error("Truncated zstd input.");
+        }
+    }
+#endif
+
+}  // namespace
+
+Compression DetectCompression(std::string_view contents) noexcept {
+    if (contents.size() >= 2 && contents.compare(0, 2, "\x1f\x8b") == 0) {
+        return Compression::kGzip;
+    } else if (contents.size() >= 4 && contents.compare(0, 4, "\x28\xb5\x2f\xfd") == 0) {
+        return Compression::kZstd;
+    }
+    return Compression::kNone;
+}
+
+DecompressedStream::DecompressedStream(MappedFile& file, Compression compression, size_t max_line_bytes) :
+        file_(file),
+        compression_(compression),
+        max_line_bytes_(max_line_bytes),
+        worker_(&DecompressedStream::Decompress, this) {}
+
+DecompressedStream::~DecompressedStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_ = true;
+    }
+    changed_.notify_all();
+    worker_.join();
+}
+
+std::string_view DecompressedStream::NextBlock() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (current_.capacity() > 0) {
+        free_.push_back(std::move(current_));
+        current_ = std::string();
+    }
+    changed_.wait(lock, [&] { return !ready_.empty() || finished_; });
+    if (!ready_.empty()) {
+        current_ = std::move(ready_.front().text);
+        current_skipped_bytes_ = ready_.front().skipped_bytes;
+        ready_.pop_front();
+        changed_.notify_all();
+        return current_;
+    }
+    if (failure_) {
+        std::rethrow_exception(failure_);
+    }
+    return {};
+}
+
+void DecompressedStream::Decompress() {
+    try {
+        std::string block = TakeFreeBlock();
+        size_t released = 0;
+        // Set while the rest of a line that was cut short is dropped, counting the bytes dropped so far.
+        bool skipping = false;
+        uint64_t skipped = 0;
+        // Cuts blocks after their last newline, carrying the partial line over into the next one. Stops the
+        // decompressor as soon as the reader has gone away rather than only once the next block is full.
+        auto write = [&](const char* data, size_t size, size_t consumed) {
+            if (cancelled_.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            if (consumed - released >= kReleaseInterval) {
+                file_.Release(released, consumed);
+                released = consumed;
+            }
+            if (skipping) {
+                // The line that was cut goes to the reader on its own once its newline is found.
+                const void* newline = std::memchr(data, '\n', size);
+                size_t dropped = newline ? size_t(static_cast<const char*>(newline) - data) + 1 : size;
+                skipped += dropped;
+                if (!newline) {
+                    return true;
+                }
+                skipping = false;
+                if (!Push({std::move(block), skipped})) {
+                    return false;
+                }
+                block = TakeFreeBlock();
+                skipped = 0;
+                data += dropped;
+                size -= dropped;
+            }
+            size_t searched = block.size() < kBlockBytes ? 0 : block.size();  // A full block has no newline before.
+            block.append(data, size);
+            if (block.size() < kBlockBytes) {
+                return true;
+            }
+            size_t newline = std::string_view(block).substr(searched).rfind('\n');
+            if (newline == std::string::npos) {
+                // The whole block is one line, which is cut short once it is too long.
+                if (max_line_bytes_ != 0 && block.size() > max_line_bytes_) {
+                    skipped = block.size() - (max_line_bytes_ + 1);
+                    block.resize(max_line_bytes_ + 1);
+                    skipping = true;
+                }
+                return true;
+            }
+            newline += searched;
+            std::string next = TakeFreeBlock();
+            next.assign(block, newline + 1, std::string::npos);
+            block.resize(newline + 1);
+            bool keep_going = Push({std::move(block), 0});
+            block = std::move(next);
+            return keep_going;
+        };
+
+        std::string_view contents = file_.contents();
+        if (compression_ == Compression::kGzip) {
+#if defined(WINDING_NUMBER_HAVE_ZLIB)
+            InflateGzip(contents, write);
+#else
+            throw std::runtime_error("This build cannot read gzip compressed files, it was built without zlib.");
+#endif
+        } else {
+#if defined(WINDING_NUMBER_HAVE_ZSTD)
+            DecompressZstd(contents, write);
+#else
+            throw std::runtime_error("This build cannot read zstd compressed files, it was built without libzstd.");
+#endif
+        }
+        if (!block.empty()) {
+            Push({std::move(block), skipped});
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failure_ = std::current_exception();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+    }
+    changed_.notify_all();
+}
+
+bool DecompressedStream::Push(Block block) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [&] { return cancelled_ || ready_.size() < kMaxReadyBlocks; });
+    if (cancelled_) {
+        return false;
+    }
+    ready_.push_back(std::move(block));
+    changed_.notify_all();
+    return true;
+}
+
+std::string DecompressedStream::TakeFreeBlock() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string block;
+    if (free_.empty()) {
+        block.reserve(kBlockBytes + kChunkBytes);
+    } else {
+        block = std::move(free_.back());
+        free_.pop_back();
+        block.clear();
+    }
+    return block;
+}
+
+}  // namespace internal
+}  // namespace poly
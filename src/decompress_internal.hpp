@@ -0,0 +1,87 @@
+#ifndef DECOMPRESS_INTERNAL_HPP_
+#define DECOMPRESS_INTERNAL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "mapped_file_internal.hpp"
+
+namespace poly {
+namespace internal {
+
+enum class Compression {
+    kNone,
+    kGzip,  // Read when the build has zlib, WINDING_NUMBER_HAVE_ZLIB.
+    kZstd,  // Read when the build has libzstd, WINDING_NUMBER_HAVE_ZSTD.
+};
+
+// Tells compressed contents apart by their magic bytes.
+Compression DetectCompression(std::string_view contents) noexcept;
+
+// The text of a compressed file, decompressed on a thread of its own while the caller parses what came before. The
+// text is handed over in blocks of whole lines (save for a last line without a newline), each as soon as it is
+// decompressed, and at most a few blocks are held at a time however large the file is. The compressed input is
+// released from memory as it is consumed.
+//
+// A line longer than max_line_bytes, 0 meaning no limit, is cut to max_line_bytes + 1 bytes and ends its block
+// without a newline, so that it is still seen as too long but never held whole.
+class DecompressedStream {
+public:
+    // Starts decompressing the file's contents, which must stay mapped for the lifetime of the stream. The compression
+    // is kGzip or kZstd; uncompressed contents are parsed straight from the mapping instead.
+    DecompressedStream(MappedFile& file, Compression compression, size_t max_line_bytes = 0);
+    ~DecompressedStream();
+
+    DecompressedStream(const DecompressedStream&) = delete;
+    DecompressedStream& operator=(const DecompressedStream&) = delete;
+
+    // The next block of lines, valid until the following call. Empty once the text is exhausted. Throws a
+    // std::runtime_error when the input is corrupt or the build cannot decompress it.
+    std::string_view NextBlock();
+
+    // How many bytes, its newline included, were cut from the line that ends the block NextBlock() last returned,
+    // which offsets in the decompressed text past the block have to count.
+    uint64_t skipped_bytes() const noexcept { return current_skipped_bytes_; }
+
+private:
+    // A block waiting for the reader, with the bytes cut from its last line.
+    struct Block {
+        std::string text;
+        uint64_t skipped_bytes = 0;
+    };
+
+    void Decompress();
+    // Hands a block over to the reader, waiting while the reader is too far behind. Returns false when the reader has
+    // gone away.
+    bool Push(Block block);
+    std::string TakeFreeBlock();
+
+    MappedFile& file_;
+    Compression compression_;
+    size_t max_line_bytes_;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<Block> ready_;
+    std::vector<std::string> free_;  // Blocks the reader is done with, kept to be refilled without allocating.
+    std::string current_;            // The block the reader is on.
+    uint64_t current_skipped_bytes_ = 0;
+    bool finished_ = false;
+    std::atomic<bool> cancelled_ = false;  // Also read without the lock by the decompressor, to stop early.
+    std::exception_ptr failure_;
+    std::thread worker_;
+};
+
+}  // namespace internal
+}  // namespace poly
+
+#endif
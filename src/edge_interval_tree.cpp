@@ -0,0 +1,80 @@
+#include <edge_interval_tree.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::BuildSubtreeHighX;
+using internal::EdgeContribution;
+using internal::EdgeXExtent;
+using internal::Point;
+using internal::SubtreeRoot;
+
+}  // namespace
+
+EdgeIntervalTreePolygon::EdgeIntervalTreePolygon(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    size_t edge_count = polygon.size() - 1;
+
+    std::vector<float> low_x(edge_count), high_x(edge_count);
+    for (size_t i = 0; i < edge_count; ++i) {
+        EdgeXExtent({x_vec[i], y_vec[i]}, {x_vec[i + 1], y_vec[i + 1]}, low_x[i], high_x[i]);
+    }
+    std::vector<size_t> order(edge_count);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&low_x](size_t i, size_t j) { return low_x[i] < low_x[j]; });
+
+    edges_.reserve(edge_count);
+    low_x_.reserve(edge_count);
+    high_x_.reserve(edge_count);
+    for (size_t i : order) {
+        edges_.push_back({x_vec[i], y_vec[i], x_vec[i + 1], y_vec[i + 1]});
+        low_x_.push_back(low_x[i]);
+        high_x_.push_back(high_x[i]);
+    }
+    subtree_high_x_.resize(edge_count);
+    BuildSubtreeHighX(high_x_, subtree_high_x_, 0, edge_count);
+}
+
+int EdgeIntervalTreePolygon::CalculateWindingNumber2D(float x, float y) const {
+    Point p = {x, y};
+    int winding_number = 0;
+
+    // Depth first over the implicit tree, the depth is bounded by log2 of the edge count.
+    std::pair<size_t, size_t> pending[64];
+    size_t pending_count = 0;
+    pending[pending_count++] = {0, edges_.size()};
+    while (pending_count > 0) {
+        auto [first, last] = pending[--pending_count];
+        if (first >= last) continue;
+        size_t root = SubtreeRoot(first, last);
+        if (subtree_high_x_[root] < x) continue;
+
+        // Everything to the left starts no later than the root, so it is worth visiting while its extents reach x.
+        pending[pending_count++] = {first, root};
+        if (low_x_[root] <= x) {
+            if (high_x_[root] >= x) {
+                const Edge& edge = edges_[root];
+                winding_number += EdgeContribution({edge.ax, edge.ay}, {edge.bx, edge.by}, p);
+            }
+            pending[pending_count++] = {root + 1, last};
+        }
+    }
+    return winding_number;
+}
+
+Engine EdgeIntervalTreePolygon::engine() const noexcept {
+    return Engine::kEdgeIntervalTree;
+}
+
+size_t EdgeIntervalTreePolygon::edge_count() const noexcept {
+    return edges_.size();
+}
+
+}  // namespace winding_number
@@ -0,0 +1,184 @@
+#include <generalized_winding.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace winding_number {
+namespace {
+
+// Groups of at most this many edges are not split any further.
+constexpr size_t kMaxLeafEdges = 8;
+
+constexpr double kTwoPi = 6.283185307179586;
+
+}  // namespace
+
+GeneralizedWindingNumber::GeneralizedWindingNumber(const poly::Polygon& polyline, float accuracy) :
+        accuracy_(accuracy) {
+    const auto& x_vec = polyline.x_vec_;
+    const auto& y_vec = polyline.y_vec_;
+    for (size_t i = 0; i + 1 < polyline.size(); ++i) {
+        edges_.push_back({x_vec[i], y_vec[i], x_vec[i + 1], y_vec[i + 1]});
+    }
+    if (!edges_.empty()) {
+        nodes_.reserve(2 * edges_.size() / kMaxLeafEdges + 1);
+        Build(0, edges_.size());
+    }
+}
+
+int GeneralizedWindingNumber::Build(size_t first_edge, size_t last_edge) {
+    float min_x = std::numeric_limits<float>::max(), min_y = min_x;
+    float max_x = std::numeric_limits<float>::lowest(), max_y = max_x;
+    for (size_t i = first_edge; i < last_edge; ++i) {
+        const Edge& edge = edges_[i];
+        min_x = std::min({min_x, edge.ax, edge.bx});
+        min_y = std::min({min_y, edge.ay, edge.by});
+        max_x = std::max({max_x, edge.ax, edge.bx});
+        max_y = std::max({max_y, edge.ay, edge.by});
+    }
+
+    Node node = {};
+    node.center_x = 0.5f * (min_x + max_x);
+    node.center_y = 0.5f * (min_y + max_y);
+    node.radius = 0.5f * std::hypot(max_x - min_x, max_y - min_y);
+    node.first_edge = first_edge;
+    node.last_edge = last_edge;
+    node.left_child = -1;
+    node.right_child = -1;
+    for (size_t i = first_edge; i < last_edge; ++i) {
+        const Edge& edge = edges_[i];
+        double tangent[2] = {double(edge.bx) - edge.ax, double(edge.by) - edge.ay};
+        double offset[2] = {double(edge.ax) - node.center_x, double(edge.ay) - node.center_y};
+        for (int k = 0; k < 2; ++k) {
+            node.tangent[k] += tangent[k];
+            for (int m = 0; m < 2; ++m) {
+                // The offset runs linearly from the edge's start to its end, integrate over that.
+                node.moment[k][m] += (offset[k] + 0.5 * tangent[k]) * tangent[m];
+                for (int l = 0; l < 2; ++l) {
+                    double offset_kl = offset[k] * offset[l] + 0.5 * (offset[k] * tangent[l] + tangent[k] * offset[l]) +
+                                       tangent[k] * tangent[l] / 3.0;
+                    node.second_moment[k][l][m] += offset_kl * tangent[m];
+                }
+            }
+        }
+    }
+
+    int index = int(nodes_.size());
+    nodes_.push_back(node);
+    if (last_edge - first_edge <= kMaxLeafEdges) {
+        return index;
+    }
+
+    // Split at the median edge midpoint along the longer side of the group's bounding box.
+    bool split_x = (max_x - min_x) >= (max_y - min_y);
+    size_t middle = first_edge + (last_edge - first_edge) / 2;
+    std::nth_element(edges_.begin() + first_edge, edges_.begin() + middle, edges_.begin() + last_edge,
+                     [split_x](const Edge& lhs, const Edge& rhs) {
+                         return split_x ? (lhs.ax + lhs.bx) < (rhs.ax + rhs.bx) : (lhs.ay + lhs.by) < (rhs.ay + rhs.by);
+                     });
+    int left_child = Build(first_edge, middle);
+    int right_child = Build(middle, last_edge);
+    nodes_[index].left_child = left_child;
+    nodes_[index].right_child = right_child;
+    return index;
+}
+
+double GeneralizedWindingNumber::ExactAngle(size_t first_edge, size_t last_edge, float x, float y) const {
+    double angle = 0;
+    for (size_t i = first_edge; i < last_edge; ++i) {
+        const Edge& edge = edges_[i];
+        double ax = double(edge.ax) - x, ay = double(edge.ay) - y;
+        double bx = double(edge.bx) - x, by = double(edge.by) - y;
+        double cross = ax * by - ay * bx;
+        double dot = ax * bx + ay * by;
+        // A point on the edge itself sees it sweep half a turn either way, take the principal value of zero so the
+        // boundary sits halfway between inside and outside.
+        if (cross == 0 && dot < 0) continue;
+        angle += std::atan2(cross, dot);
+    }
+    return angle;
+}
+
+float GeneralizedWindingNumber::Calculate(float x, float y) const {
+    if (nodes_.empty()) {
+        return 0.f;
+    }
+
+    double angle = 0;
+    int pending[128];
+    size_t pending_count = 0;
+    pending[pending_count++] = 0;
+    while (pending_count > 0) {
+        const Node& node = nodes_[pending[--pending_count]];
+        double to_center_x = double(node.center_x) - x;
+        double to_center_y = double(node.center_y) - y;
+        double distance_squared = to_center_x * to_center_x + to_center_y * to_center_y;
+        double reach = double(accuracy_) * node.radius;
+
+        if (distance_squared > reach * reach) {
+            // The swept angle of an edge element is cross(g(r), t) for r from the query point to the element and
+            // g(r) = r / |r|^2. Expanding g about the group's center to second order turns the sum over the group's
+            // edges into a contraction of g's derivatives with the group's moments.
+            double r[2] = {to_center_x, to_center_y};
+            double inverse = 1.0 / distance_squared;
+            double g[2], jacobian[2][2], hessian[2][2][2];
+            for (int i = 0; i < 2; ++i) {
+                g[i] = r[i] * inverse;
+                for (int k = 0; k < 2; ++k) {
+                    jacobian[i][k] = ((i == k) - 2.0 * r[i] * r[k] * inverse) * inverse;
+                    for (int l = 0; l < 2; ++l) {
+                        hessian[i][k][l] = (-2.0 * ((i == k) * r[l] + (i == l) * r[k] + (k == l) * r[i]) +
+                                            8.0 * r[i] * r[k] * r[l] * inverse) *
+                                           inverse * inverse;
+                    }
+                }
+            }
+            // cross(u, t) = u.x * t.y - u.y * t.x, so each component of the expansion meets the other tangent axis.
+            for (int i = 0; i < 2; ++i) {
+                int m = 1 - i;
+                double sign = (i == 0) ? 1.0 : -1.0;
+                double term = g[i] * node.tangent[m];
+                for (int k = 0; k < 2; ++k) {
+                    term += jacobian[i][k] * node.moment[k][m];
+                    for (int l = 0; l < 2; ++l) {
+                        term += 0.5 * hessian[i][k][l] * node.second_moment[k][l][m];
+                    }
+                }
+                angle += sign * term;
+            }
+        } else if (node.left_child < 0) {
+            angle += ExactAngle(node.first_edge, node.last_edge, x, y);
+        } else {
+            pending[pending_count++] = node.left_child;
+            pending[pending_count++] = node.right_child;
+        }
+    }
+    return float(angle / kTwoPi);
+}
+
+float GeneralizedWindingNumber::CalculateExact(float x, float y) const {
+    return float(ExactAngle(0, edges_.size(), x, y) / kTwoPi);
+}
+
+int GeneralizedWindingNumber::CalculateWindingNumber2D(float x, float y) const {
+    return int(std::lround(Calculate(x, y)));
+}
+
+float GeneralizedWindingNumber::accuracy() const noexcept {
+    return accuracy_;
+}
+
+void GeneralizedWindingNumber::accuracy(float accuracy) noexcept {
+    accuracy_ = accuracy;
+}
+
+size_t GeneralizedWindingNumber::edge_count() const noexcept {
+    return edges_.size();
+}
+
+size_t GeneralizedWindingNumber::node_count() const noexcept {
+    return nodes_.size();
+}
+
+}  // namespace winding_number
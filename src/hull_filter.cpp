@@ -0,0 +1,204 @@
+#include <hull_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeXExtent;
+using internal::FuzzyEquals;
+using internal::InteriorPoint;
+using internal::Point;
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Both hulls keep this far (relative to the polygon's coordinates) from anything an edge can affect, to absorb the
+// rounding of the float cross products that decide which side of an edge a point is on.
+constexpr double kRelativeMargin = 1e-5;
+
+// Sectors are widened by this angle on either side when edges are clipped to them. The wedge boundaries come from
+// rounded sines and cosines, so without it a vertex lying exactly on the ray between two sectors can be clipped out of
+// both, while a query at that vertex is still assigned to one of them.
+constexpr double kAngularSlack = 1e-9;
+
+// Distance from the origin to the part of the segment [a, b] inside the wedge between the directions u and v, which
+// are less than half a turn apart, or infinity when the segment misses the wedge.
+double DistanceWithinWedge(double ax, double ay, double bx, double by, double ux, double uy, double vx, double vy) {
+    double t0 = 0, t1 = 1;
+    // Clip against cross(u, q) >= 0 and cross(q, v) >= 0, both linear in the segment's parameter.
+    const double starts[2] = {ux * ay - uy * ax, ax * vy - ay * vx};
+    const double slopes[2] = {ux * (by - ay) - uy * (bx - ax), (bx - ax) * vy - (by - ay) * vx};
+    for (int i = 0; i < 2; ++i) {
+        if (slopes[i] == 0) {
+            if (starts[i] < 0) {
+                return std::numeric_limits<double>::infinity();
+            }
+        } else if (slopes[i] > 0) {
+            t0 = std::max(t0, -starts[i] / slopes[i]);
+        } else {
+            t1 = std::min(t1, -starts[i] / slopes[i]);
+        }
+    }
+    if (t0 > t1) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double dx = bx - ax, dy = by - ay;
+    double length_squared = dx * dx + dy * dy;
+    double t = length_squared > 0 ? -(ax * dx + ay * dy) / length_squared : t0;
+    t = std::min(std::max(t, t0), t1);
+    return std::hypot(ax + t * dx, ay + t * dy);
+}
+
+}  // namespace
+
+float HullFilterStatistics::early_resolution_fraction() const noexcept {
+    if (query_count == 0) {
+        return 0.f;
+    }
+    return float(resolved_early_count) / float(query_count);
+}
+
+HullFilteredPolygon::HullFilteredPolygon(const poly::Polygon& polygon, std::unique_ptr<IPreparedPolygon> fallback) :
+        fallback_(std::move(fallback)) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    const double sector_width = 2 * kPi / kDirections;
+    for (size_t k = 0; k < kDirections; ++k) {
+        double angle = -kPi + (k + 0.5) * sector_width;
+        direction_x_[k] = std::cos(angle);
+        direction_y_[k] = std::sin(angle);
+        outer_extent_[k] = std::numeric_limits<double>::lowest();
+        inner_extent_[k] = std::numeric_limits<double>::infinity();
+    }
+
+    double scale = 1;
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        scale = std::max({scale, double(std::abs(x_vec[i])), double(std::abs(y_vec[i]))});
+    }
+    double margin = kRelativeMargin * scale;
+
+    auto [center_x, center_y] = InteriorPoint(polygon, *fallback_);
+    center_x_ = center_x;
+    center_y_ = center_y;
+    inner_winding_number_ = fallback_->CalculateWindingNumber2D(center_x, center_y);
+
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        Point a = {x_vec[i], y_vec[i]};
+        Point b = {x_vec[i + 1], y_vec[i + 1]};
+        // The outer hull has to hold the whole area in which the edge contributes, which for upward near-vertical
+        // edges is wider than the edge itself.
+        float lo, hi;
+        EdgeXExtent(a, b, lo, hi);
+        const double corners[4][2] = {{lo, a.y}, {hi, a.y}, {lo, b.y}, {hi, b.y}};
+        for (size_t k = 0; k < kDirections; ++k) {
+            for (const auto& corner : corners) {
+                double projection = corner[0] * direction_x_[k] + corner[1] * direction_y_[k];
+                outer_extent_[k] = std::max(outer_extent_[k], projection);
+            }
+        }
+
+        double ax = a.x - center_x_, ay = a.y - center_y_;
+        double bx = b.x - center_x_, by = b.y - center_y_;
+        if (FuzzyEquals(a.x, b.x) && a.y < b.y) {
+            // Keep every sector the widened edge could reach clear of the disc around it.
+            double mid_x = 0.5 * (ax + bx), mid_y = 0.5 * (ay + by);
+            double radius = 0.5 * (b.y - a.y) + 1.5 * (hi - lo) + margin;
+            double distance = std::hypot(mid_x, mid_y);
+            double spread = distance > radius ? std::asin(radius / distance) : kPi;
+            double angle = std::atan2(mid_y, mid_x);
+            for (size_t k = 0; k < kDirections; ++k) {
+                double offset = std::remainder(std::atan2(direction_y_[k], direction_x_[k]) - angle, 2 * kPi);
+                if (std::abs(offset) <= spread + sector_width / 2 + kAngularSlack) {
+                    inner_extent_[k] = std::min(inner_extent_[k], std::max(0.0, distance - radius));
+                }
+            }
+            continue;
+        }
+        for (size_t k = 0; k < kDirections; ++k) {
+            double start = -kPi + k * sector_width - kAngularSlack;
+            double end = start + sector_width + 2 * kAngularSlack;
+            double distance = DistanceWithinWedge(ax, ay, bx, by, std::cos(start), std::sin(start), std::cos(end),
+                                                  std::sin(end));
+            inner_extent_[k] = std::min(inner_extent_[k], distance);
+        }
+    }
+
+    // The triangles only share the interior point's winding number if they are connected through a boundary-free
+    // disc around it. Otherwise an edge running through the interior point would separate them.
+    double clearance = *std::min_element(inner_extent_, inner_extent_ + kDirections);
+    // Each sector's triangle is inscribed in the boundary-free disc of its sector, so it reaches along the bisector to
+    // the disc's radius times cos(half the sector's width).
+    for (size_t k = 0; k < kDirections; ++k) {
+        outer_extent_[k] += margin;
+        if (clearance <= margin) {
+            inner_extent_[k] = 0;
+        } else {
+            inner_extent_[k] = (inner_extent_[k] - margin) * std::cos(sector_width / 2);
+        }
+    }
+}
+
+bool HullFilteredPolygon::InsideInnerHull(double x, double y) const {
+    double dx = x - center_x_, dy = y - center_y_;
+    auto k = size_t((std::atan2(dy, dx) + kPi) * (kDirections / (2 * kPi)));
+    k = std::min(k, kDirections - 1);
+    return dx * direction_x_[k] + dy * direction_y_[k] < inner_extent_[k];
+}
+
+bool HullFilteredPolygon::OutsideOuterHull(double x, double y) const {
+    for (size_t k = 0; k < kDirections; ++k) {
+        if (x * direction_x_[k] + y * direction_y_[k] > outer_extent_[k]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<int> HullFilteredPolygon::ResolveEarly(float x, float y) const {
+    if (InsideInnerHull(x, y)) {
+        return inner_winding_number_;
+    }
+    if (OutsideOuterHull(x, y)) {
+        return 0;
+    }
+    return std::nullopt;
+}
+
+int HullFilteredPolygon::CalculateWindingNumber2D(float x, float y) const {
+    if (auto winding_number = ResolveEarly(x, y)) {
+        return *winding_number;
+    }
+    return fallback_->CalculateWindingNumber2D(x, y);
+}
+
+int HullFilteredPolygon::CalculateWindingNumber2D(float x, float y, HullFilterStatistics& statistics) const {
+    ++statistics.query_count;
+    if (auto winding_number = ResolveEarly(x, y)) {
+        ++statistics.resolved_early_count;
+        return *winding_number;
+    }
+    return fallback_->CalculateWindingNumber2D(x, y);
+}
+
+Engine HullFilteredPolygon::engine() const noexcept {
+    return Engine::kHullFilter;
+}
+
+int HullFilteredPolygon::inner_winding_number() const noexcept {
+    return inner_winding_number_;
+}
+
+float HullFilteredPolygon::inner_coverage() const noexcept {
+    size_t covered = 0;
+    for (size_t k = 0; k < kDirections; ++k) {
+        covered += inner_extent_[k] > 0;
+    }
+    return float(covered) / kDirections;
+}
+
+}  // namespace winding_number
@@ -0,0 +1,91 @@
+#include "mapped_file_internal.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define POLY_IO_MMAP 1
+#endif
+
+namespace poly {
+namespace internal {
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(POLY_IO_MMAP)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open:\t" + path + "\nError:\t\t" + std::strerror(errno));
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        int error = errno;
+        close(fd);
+        throw std::runtime_error("Failed to open:\t" + path + "\nError:\t\t" + std::strerror(error));
+    }
+    size_ = size_t(status.st_size);
+    if (size_ > 0) {
+        void* address = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            madvise(address, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(address);
+            mapped_ = true;
+        }
+    }
+    close(fd);
+    if (mapped_) {
+        return;
+    }
+    // Some files, such as those on special file systems, cannot be mapped, and some (procfs, sysfs and some FUSE files)
+    // report a size of 0 while they have contents. Read them instead.
+#endif
+    std::ifstream fs(path, std::ios::in | std::ios::binary);
+    if (!fs) {
+        throw std::runtime_error("Failed to open:\t" + path);
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+    if (fs.bad()) {
+        throw std::runtime_error("Failed to read:\t" + path);
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+#if defined(POLY_IO_MMAP)
+    if (mapped_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+std::string_view MappedFile::contents() const noexcept {
+    return std::string_view(data_, size_);
+}
+
+void MappedFile::Release(size_t first, size_t last) noexcept {
+#if defined(POLY_IO_MMAP)
+    if (mapped_) {
+        // Only whole pages can be released, and the page holding last may still be read.
+        size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+        first = first / page_size * page_size;
+        last = std::min(last, size_) / page_size * page_size;
+        if (first < last) {
+            madvise(const_cast<char*>(data_) + first, last - first, MADV_DONTNEED);
+        }
+    }
+#else
+    (void)first;
+    (void)last;
+#endif
+}
+
+}  // namespace internal
+}  // namespace poly
@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_INTERNAL_HPP_
+#define MAPPED_FILE_INTERNAL_HPP_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace poly {
+namespace internal {
+
+// The read-only contents of a file. On POSIX systems the file is memory mapped and the kernel is told it will be read
+// front to back, so pages are read ahead and dropped behind instead of being copied through a stream buffer. Elsewhere
+// the file is read into memory in one go.
+class MappedFile {
+public:
+    // Throws a std::runtime_error when the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view contents() const noexcept;
+
+    // Tells the kernel that the contents in [first, last) will not be read again, so that their pages can be dropped.
+    // The contents stay valid and are read back from the file if they are touched anyway.
+    void Release(size_t first, size_t last) noexcept;
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_;  // The contents when the file could not be mapped.
+};
+
+}  // namespace internal
+}  // namespace poly
+
+#endif
@@ -0,0 +1,29 @@
+#include <mesh.hpp>
+
+#include <cassert>
+
+namespace poly {
+
+uint32_t TriangleMesh::AppendVertex(float x, float y, float z) {
+    x_vec_.push_back(x);
+    y_vec_.push_back(y);
+    z_vec_.push_back(z);
+    return uint32_t(x_vec_.size() - 1);
+}
+
+void TriangleMesh::AppendTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    assert(a < vertex_count() && b < vertex_count() && c < vertex_count());
+    triangles_.insert(triangles_.end(), {a, b, c});
+}
+
+size_t TriangleMesh::vertex_count() const {
+    size_t x_vec_size = x_vec_.size();
+    assert(x_vec_size == y_vec_.size() && x_vec_size == z_vec_.size());
+    return x_vec_size;
+}
+
+size_t TriangleMesh::triangle_count() const {
+    return triangles_.size() / 3;
+}
+
+}  // namespace poly
@@ -0,0 +1,233 @@
+#include <mesh_winding.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace winding_number {
+namespace {
+
+// Groups of at most this many triangles are not split any further.
+constexpr size_t kMaxLeafTriangles = 8;
+
+constexpr double kFourPi = 12.566370614359172;
+
+}  // namespace
+
+MeshWindingNumber::MeshWindingNumber(const poly::TriangleMesh& mesh, float accuracy) : accuracy_(accuracy) {
+    const auto& x_vec = mesh.x_vec_;
+    const auto& y_vec = mesh.y_vec_;
+    const auto& z_vec = mesh.z_vec_;
+    triangles_.reserve(mesh.triangle_count());
+    for (size_t i = 0; i < mesh.triangle_count(); ++i) {
+        uint32_t a = mesh.triangles_[3 * i], b = mesh.triangles_[3 * i + 1], c = mesh.triangles_[3 * i + 2];
+        triangles_.push_back({x_vec[a], y_vec[a], z_vec[a], x_vec[b], y_vec[b], z_vec[b], x_vec[c], y_vec[c], z_vec[c]});
+    }
+    if (!triangles_.empty()) {
+        nodes_.reserve(2 * triangles_.size() / kMaxLeafTriangles + 1);
+        Build(0, triangles_.size());
+    }
+}
+
+int MeshWindingNumber::Build(size_t first_triangle, size_t last_triangle) {
+    float min[3], max[3];
+    std::fill(min, min + 3, std::numeric_limits<float>::max());
+    std::fill(max, max + 3, std::numeric_limits<float>::lowest());
+    for (size_t i = first_triangle; i < last_triangle; ++i) {
+        const float* coordinates = &triangles_[i].ax;
+        for (int vertex = 0; vertex < 3; ++vertex) {
+            for (int axis = 0; axis < 3; ++axis) {
+                min[axis] = std::min(min[axis], coordinates[3 * vertex + axis]);
+                max[axis] = std::max(max[axis], coordinates[3 * vertex + axis]);
+            }
+        }
+    }
+
+    Node node = {};
+    for (int axis = 0; axis < 3; ++axis) {
+        node.center[axis] = 0.5f * (min[axis] + max[axis]);
+    }
+    node.radius = 0.5f * std::sqrt((max[0] - min[0]) * (max[0] - min[0]) + (max[1] - min[1]) * (max[1] - min[1]) +
+                                   (max[2] - min[2]) * (max[2] - min[2]));
+    node.first_triangle = first_triangle;
+    node.last_triangle = last_triangle;
+    node.left_child = -1;
+    node.right_child = -1;
+    for (size_t i = first_triangle; i < last_triangle; ++i) {
+        const float* coordinates = &triangles_[i].ax;
+        double offset[3][3], sum[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            sum[axis] = 0;
+            for (int vertex = 0; vertex < 3; ++vertex) {
+                offset[vertex][axis] = double(coordinates[3 * vertex + axis]) - node.center[axis];
+                sum[axis] += offset[vertex][axis];
+            }
+        }
+        double ab[3], ac[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            ab[axis] = offset[1][axis] - offset[0][axis];
+            ac[axis] = offset[2][axis] - offset[0][axis];
+        }
+        // Area weighted normal, the integral of the unit normal over the triangle.
+        double normal[3] = {0.5 * (ab[1] * ac[2] - ab[2] * ac[1]), 0.5 * (ab[2] * ac[0] - ab[0] * ac[2]),
+                            0.5 * (ab[0] * ac[1] - ab[1] * ac[0])};
+        for (int i_axis = 0; i_axis < 3; ++i_axis) {
+            node.normal[i_axis] += normal[i_axis];
+            for (int j = 0; j < 3; ++j) {
+                // The offset integrates to the centroid, and offset x offset to a twelfth of the vertex outer
+                // products plus the outer product of their sum (both per unit area).
+                node.moment[j][i_axis] += sum[j] / 3.0 * normal[i_axis];
+                for (int k = 0; k < 3; ++k) {
+                    double outer = sum[j] * sum[k];
+                    for (int vertex = 0; vertex < 3; ++vertex) {
+                        outer += offset[vertex][j] * offset[vertex][k];
+                    }
+                    node.second_moment[j][k][i_axis] += outer / 12.0 * normal[i_axis];
+                }
+            }
+        }
+    }
+
+    int index = int(nodes_.size());
+    nodes_.push_back(node);
+    if (last_triangle - first_triangle <= kMaxLeafTriangles) {
+        return index;
+    }
+
+    // Split at the median centroid along the longest side of the group's bounding box.
+    int split_axis = 0;
+    for (int axis = 1; axis < 3; ++axis) {
+        if (max[axis] - min[axis] > max[split_axis] - min[split_axis]) {
+            split_axis = axis;
+        }
+    }
+    size_t middle = first_triangle + (last_triangle - first_triangle) / 2;
+    std::nth_element(triangles_.begin() + first_triangle, triangles_.begin() + middle,
+                     triangles_.begin() + last_triangle, [split_axis](const Triangle& lhs, const Triangle& rhs) {
+                         const float* l = &lhs.ax;
+                         const float* r = &rhs.ax;
+                         return l[split_axis] + l[3 + split_axis] + l[6 + split_axis] <
+                                r[split_axis] + r[3 + split_axis] + r[6 + split_axis];
+                     });
+    int left_child = Build(first_triangle, middle);
+    int right_child = Build(middle, last_triangle);
+    nodes_[index].left_child = left_child;
+    nodes_[index].right_child = right_child;
+    return index;
+}
+
+double MeshWindingNumber::ExactSolidAngle(size_t first_triangle, size_t last_triangle, float x, float y,
+                                          float z) const {
+    double solid_angle = 0;
+    for (size_t i = first_triangle; i < last_triangle; ++i) {
+        const Triangle& t = triangles_[i];
+        double a[3] = {double(t.ax) - x, double(t.ay) - y, double(t.az) - z};
+        double b[3] = {double(t.bx) - x, double(t.by) - y, double(t.bz) - z};
+        double c[3] = {double(t.cx) - x, double(t.cy) - y, double(t.cz) - z};
+        double a_length = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+        double b_length = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+        double c_length = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+        double determinant = a[0] * (b[1] * c[2] - b[2] * c[1]) - a[1] * (b[0] * c[2] - b[2] * c[0]) +
+                             a[2] * (b[0] * c[1] - b[1] * c[0]);
+        double ab = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        double ac = a[0] * c[0] + a[1] * c[1] + a[2] * c[2];
+        double bc = b[0] * c[0] + b[1] * c[1] + b[2] * c[2];
+        // Van Oosterom and Strackee's formula for the solid angle of a triangle.
+        double denominator = a_length * b_length * c_length + ab * c_length + ac * b_length + bc * a_length;
+        solid_angle += 2 * std::atan2(determinant, denominator);
+    }
+    return solid_angle;
+}
+
+float MeshWindingNumber::Calculate(float x, float y, float z) const {
+    if (nodes_.empty()) {
+        return 0.f;
+    }
+
+    double solid_angle = 0;
+    int pending[128];
+    size_t pending_count = 0;
+    pending[pending_count++] = 0;
+    while (pending_count > 0) {
+        const Node& node = nodes_[pending[--pending_count]];
+        double r[3] = {double(node.center[0]) - x, double(node.center[1]) - y, double(node.center[2]) - z};
+        double distance_squared = r[0] * r[0] + r[1] * r[1] + r[2] * r[2];
+        double reach = double(accuracy_) * node.radius;
+
+        if (distance_squared > reach * reach) {
+            // A surface element sees the point under the solid angle g(r) . n dA for g(r) = r / |r|^3, with r from
+            // the point to the element. Expand g about the group's center to second order.
+            double inverse = 1.0 / distance_squared;
+            double inverse_cube = inverse * std::sqrt(inverse);
+            for (int i = 0; i < 3; ++i) {
+                double term = r[i] * inverse_cube * node.normal[i];
+                for (int j = 0; j < 3; ++j) {
+                    double jacobian = ((i == j) - 3.0 * r[i] * r[j] * inverse) * inverse_cube;
+                    term += jacobian * node.moment[j][i];
+                    for (int k = 0; k < 3; ++k) {
+                        double hessian = (-3.0 * ((i == j) * r[k] + (i == k) * r[j] + (j == k) * r[i]) +
+                                          15.0 * r[i] * r[j] * r[k] * inverse) *
+                                         inverse * inverse_cube;
+                        term += 0.5 * hessian * node.second_moment[j][k][i];
+                    }
+                }
+                solid_angle += term;
+            }
+        } else if (node.left_child < 0) {
+            solid_angle += ExactSolidAngle(node.first_triangle, node.last_triangle, x, y, z);
+        } else {
+            pending[pending_count++] = node.left_child;
+            pending[pending_count++] = node.right_child;
+        }
+    }
+    return float(solid_angle / kFourPi);
+}
+
+float MeshWindingNumber::CalculateExact(float x, float y, float z) const {
+    return float(ExactSolidAngle(0, triangles_.size(), x, y, z) / kFourPi);
+}
+
+int MeshWindingNumber::CalculateWindingNumber3D(float x, float y, float z) const {
+    return int(std::lround(Calculate(x, y, z)));
+}
+
+void MeshWindingNumber::Calculate(const float* x, const float* y, const float* z, size_t count,
+                                  float* winding_numbers) const {
+    for (size_t i = 0; i < count; ++i) {
+        winding_numbers[i] = Calculate(x[i], y[i], z[i]);
+    }
+}
+
+std::vector<float> MeshWindingNumber::CalculateVoxelGrid(float origin_x, float origin_y, float origin_z, float spacing,
+                                                         size_t size_x, size_t size_y, size_t size_z) const {
+    std::vector<float> winding_numbers;
+    winding_numbers.reserve(size_x * size_y * size_z);
+    for (size_t k = 0; k < size_z; ++k) {
+        float z = origin_z + (k + 0.5f) * spacing;
+        for (size_t j = 0; j < size_y; ++j) {
+            float y = origin_y + (j + 0.5f) * spacing;
+            for (size_t i = 0; i < size_x; ++i) {
+                winding_numbers.push_back(Calculate(origin_x + (i + 0.5f) * spacing, y, z));
+            }
+        }
+    }
+    return winding_numbers;
+}
+
+float MeshWindingNumber::accuracy() const noexcept {
+    return accuracy_;
+}
+
+void MeshWindingNumber::accuracy(float accuracy) noexcept {
+    accuracy_ = accuracy;
+}
+
+size_t MeshWindingNumber::triangle_count() const noexcept {
+    return triangles_.size();
+}
+
+size_t MeshWindingNumber::node_count() const noexcept {
+    return nodes_.size();
+}
+
+}  // namespace winding_number
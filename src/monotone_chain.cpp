@@ -0,0 +1,168 @@
+#include <monotone_chain.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeContribution;
+using internal::EdgeXExtent;
+using internal::FuzzyEquals;
+using internal::Point;
+
+// Which way an edge heads in x. Only edges heading the same way can share a chain.
+enum class Heading { kVertical, kRight, kLeft };
+
+Heading EdgeHeading(const std::vector<float>& x_vec, size_t edge) {
+    float ax = x_vec[edge], bx = x_vec[edge + 1];
+    if (FuzzyEquals(ax, bx)) {
+        return Heading::kVertical;
+    }
+    return ax < bx ? Heading::kRight : Heading::kLeft;
+}
+
+// The first edge of a chain when walking the polygon cyclically, so that a chain is never split by the closing vertex.
+size_t FirstChainEdge(const std::vector<float>& x_vec) {
+    size_t edge_count = x_vec.size() - 1;
+    for (size_t edge = 0; edge < edge_count; ++edge) {
+        if (EdgeHeading(x_vec, edge) != EdgeHeading(x_vec, (edge + edge_count - 1) % edge_count)) {
+            return edge;
+        }
+    }
+    return 0;
+}
+
+// Sorts by the low end of each range and returns the permutation, along with the running maximum of the high ends in
+// sorted order.
+std::vector<size_t> SortByLowEnd(const std::vector<float>& lo, const std::vector<float>& hi, std::vector<float>& reach) {
+    std::vector<size_t> order(lo.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&lo](size_t i, size_t j) { return lo[i] < lo[j]; });
+    reach.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        reach[i] = (i == 0) ? hi[order[i]] : std::max(reach[i - 1], hi[order[i]]);
+    }
+    return order;
+}
+
+}  // namespace
+
+MonotoneChainPolygon::MonotoneChainPolygon(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    size_t edge_count = polygon.size() - 1;
+    size_t first_edge = FirstChainEdge(x_vec);
+
+    std::vector<Chain> chains;
+    std::vector<float> chain_lo, chain_hi;
+    std::vector<VerticalEdge> vertical_edges;
+    std::vector<float> vertical_lo, vertical_hi;
+    x_vec_.reserve(polygon.size() + edge_count / 2);
+    y_vec_.reserve(polygon.size() + edge_count / 2);
+
+    for (size_t step = 0; step < edge_count;) {
+        size_t edge = (first_edge + step) % edge_count;
+        Heading heading = EdgeHeading(x_vec, edge);
+        if (heading == Heading::kVertical) {
+            VerticalEdge vertical = {x_vec[edge], y_vec[edge], x_vec[edge + 1], y_vec[edge + 1]};
+            float lo, hi;
+            EdgeXExtent({vertical.ax, vertical.ay}, {vertical.bx, vertical.by}, lo, hi);
+            vertical_edges.push_back(vertical);
+            vertical_lo.push_back(lo);
+            vertical_hi.push_back(hi);
+            ++step;
+            continue;
+        }
+
+        // Extend the chain for as long as edges keep heading the same way.
+        size_t chain_edges = 1;
+        while (step + chain_edges < edge_count &&
+               EdgeHeading(x_vec, (first_edge + step + chain_edges) % edge_count) == heading) {
+            ++chain_edges;
+        }
+
+        Chain chain = {x_vec_.size(), x_vec_.size() + chain_edges, heading == Heading::kLeft};
+        for (size_t i = 0; i <= chain_edges; ++i) {
+            size_t offset = chain.reversed ? chain_edges - i : i;
+            size_t vertex = (first_edge + step + offset) % edge_count;
+            x_vec_.push_back(x_vec[vertex]);
+            y_vec_.push_back(y_vec[vertex]);
+        }
+        chains.push_back(chain);
+        chain_lo.push_back(x_vec_[chain.first_vertex]);
+        chain_hi.push_back(x_vec_[chain.last_vertex]);
+        step += chain_edges;
+    }
+
+    for (size_t i : SortByLowEnd(chain_lo, chain_hi, chain_reach_)) {
+        chains_.push_back(chains[i]);
+        chain_min_x_.push_back(chain_lo[i]);
+        chain_max_x_.push_back(chain_hi[i]);
+    }
+    for (size_t i : SortByLowEnd(vertical_lo, vertical_hi, vertical_reach_)) {
+        vertical_edges_.push_back(vertical_edges[i]);
+        vertical_min_x_.push_back(vertical_lo[i]);
+    }
+}
+
+int MonotoneChainPolygon::CalculateWindingNumber2D(float x, float y) const {
+    Point p = {x, y};
+    int winding_number = 0;
+
+    // A chain can only contribute through the one edge with a.x <= p.x < b.x (in increasing x order).
+    size_t candidates = std::upper_bound(chain_min_x_.begin(), chain_min_x_.end(), x) - chain_min_x_.begin();
+    for (size_t i = candidates; i-- > 0 && chain_reach_[i] > x;) {
+        if (chain_max_x_[i] <= x) continue;
+        const Chain& chain = chains_[i];
+        auto first = x_vec_.begin() + chain.first_vertex;
+        auto last = x_vec_.begin() + chain.last_vertex + 1;
+        size_t lower = (std::upper_bound(first, last, x) - x_vec_.begin()) - 1;
+        Point left = {x_vec_[lower], y_vec_[lower]};
+        Point right = {x_vec_[lower + 1], y_vec_[lower + 1]};
+        winding_number += chain.reversed ? EdgeContribution(right, left, p) : EdgeContribution(left, right, p);
+    }
+
+    candidates = std::upper_bound(vertical_min_x_.begin(), vertical_min_x_.end(), x) - vertical_min_x_.begin();
+    for (size_t i = candidates; i-- > 0 && vertical_reach_[i] >= x;) {
+        const VerticalEdge& edge = vertical_edges_[i];
+        winding_number += EdgeContribution({edge.ax, edge.ay}, {edge.bx, edge.by}, p);
+    }
+    return winding_number;
+}
+
+Engine MonotoneChainPolygon::engine() const noexcept {
+    return Engine::kMonotoneChain;
+}
+
+size_t MonotoneChainPolygon::chain_count() const noexcept {
+    return chains_.size();
+}
+
+size_t MonotoneChainPolygon::vertical_edge_count() const noexcept {
+    return vertical_edges_.size();
+}
+
+size_t MonotoneChainPolygon::CountChains(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    size_t edge_count = polygon.size() - 1;
+    size_t chain_count = 0;
+    Heading previous = EdgeHeading(x_vec, edge_count - 1);
+    for (size_t edge = 0; edge < edge_count; ++edge) {
+        Heading heading = EdgeHeading(x_vec, edge);
+        if (heading != Heading::kVertical && heading != previous) {
+            ++chain_count;
+        }
+        previous = heading;
+    }
+    // A polygon that never changes heading still forms a single chain.
+    if (chain_count == 0 && previous != Heading::kVertical) {
+        chain_count = 1;
+    }
+    return chain_count;
+}
+
+}  // namespace winding_number
@@ -0,0 +1,64 @@
+#include <path.hpp>
+
+#include <cassert>
+
+namespace poly {
+
+void Path::MoveTo(float x, float y) {
+    contours_.push_back({segments_.size(), x_vec_.size()});
+    x_vec_.push_back(x);
+    y_vec_.push_back(y);
+}
+
+void Path::LineTo(float x, float y) {
+    assert(!contours_.empty());
+    segments_.push_back(Segment::kLine);
+    x_vec_.push_back(x);
+    y_vec_.push_back(y);
+}
+
+void Path::QuadraticTo(float control_x, float control_y, float x, float y) {
+    assert(!contours_.empty());
+    segments_.push_back(Segment::kQuadratic);
+    x_vec_.insert(x_vec_.end(), {control_x, x});
+    y_vec_.insert(y_vec_.end(), {control_y, y});
+}
+
+void Path::CubicTo(float control1_x, float control1_y, float control2_x, float control2_y, float x, float y) {
+    assert(!contours_.empty());
+    segments_.push_back(Segment::kCubic);
+    x_vec_.insert(x_vec_.end(), {control1_x, control2_x, x});
+    y_vec_.insert(y_vec_.end(), {control1_y, control2_y, y});
+}
+
+void Path::ClosePath() {
+    if (contours_.empty()) {
+        return;
+    }
+    size_t first_point = contours_.back().first_point;
+    if (x_vec_.back() != x_vec_[first_point] || y_vec_.back() != y_vec_[first_point]) {
+        LineTo(x_vec_[first_point], y_vec_[first_point]);
+    }
+}
+
+size_t Path::segment_count() const {
+    return segments_.size();
+}
+
+size_t Path::contour_count() const {
+    return contours_.size();
+}
+
+size_t Path::PointCount(Segment segment) {
+    switch (segment) {
+    case Segment::kLine:
+        return 1;
+    case Segment::kQuadratic:
+        return 2;
+    case Segment::kCubic:
+        return 3;
+    }
+    return 0;
+}
+
+}  // namespace poly
@@ -0,0 +1,202 @@
+#include <path_winding.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeContribution;
+
+double Evaluate(const double (&coefficients)[4], double t) {
+    return ((coefficients[0] * t + coefficients[1]) * t + coefficients[2]) * t + coefficients[3];
+}
+
+double Derivative(const double (&coefficients)[4], double t) {
+    return (3 * coefficients[0] * t + 2 * coefficients[1]) * t + coefficients[2];
+}
+
+// Power basis coefficients of a Bezier curve of degree point_count - 1, highest power first and padded to a cubic.
+void PowerBasis(const double (&points)[4], size_t point_count, double (&coefficients)[4]) {
+    switch (point_count) {
+    case 3:
+        coefficients[0] = 0;
+        coefficients[1] = points[0] - 2 * points[1] + points[2];
+        coefficients[2] = 2 * (points[1] - points[0]);
+        coefficients[3] = points[0];
+        break;
+    case 4:
+        coefficients[0] = -points[0] + 3 * points[1] - 3 * points[2] + points[3];
+        coefficients[1] = 3 * points[0] - 6 * points[1] + 3 * points[2];
+        coefficients[2] = 3 * (points[1] - points[0]);
+        coefficients[3] = points[0];
+        break;
+    default:
+        coefficients[0] = 0;
+        coefficients[1] = 0;
+        coefficients[2] = points[1] - points[0];
+        coefficients[3] = points[0];
+        break;
+    }
+}
+
+// Coefficients of p(first + (last - first) * s) as a polynomial in s.
+void Reparameterize(const double (&coefficients)[4], double first, double last, double (&result)[4]) {
+    double a = coefficients[0], b = coefficients[1], c = coefficients[2];
+    double h = last - first;
+    result[0] = a * h * h * h;
+    result[1] = (3 * a * first + b) * h * h;
+    result[2] = (3 * a * first * first + 2 * b * first + c) * h;
+    result[3] = Evaluate(coefficients, first);
+}
+
+// Appends the roots of the polynomial's derivative that lie strictly inside (0, 1), in increasing order.
+void AppendTurningPoints(const double (&coefficients)[4], std::vector<double>& roots) {
+    double a = 3 * coefficients[0], b = 2 * coefficients[1], c = coefficients[2];
+    size_t first_root = roots.size();
+    if (a == 0) {
+        if (b != 0) {
+            roots.push_back(-c / b);
+        }
+    } else {
+        double discriminant = b * b - 4 * a * c;
+        if (discriminant >= 0) {
+            // The numerically stable form of the quadratic formula.
+            double q = -0.5 * (b + std::copysign(std::sqrt(discriminant), b));
+            roots.push_back(q / a);
+            if (q != 0) {
+                roots.push_back(c / q);
+            }
+        }
+    }
+    roots.erase(std::remove_if(roots.begin() + first_root, roots.end(), [](double t) { return t <= 0 || t >= 1; }),
+                roots.end());
+    std::sort(roots.begin() + first_root, roots.end());
+}
+
+}  // namespace
+
+PathWindingNumber::PathWindingNumber(const poly::Path& path) {
+    for (size_t contour = 0; contour < path.contours_.size(); ++contour) {
+        const auto& [first_segment, first_point] = path.contours_[contour];
+        size_t last_segment =
+                contour + 1 < path.contours_.size() ? path.contours_[contour + 1].first_segment : path.segments_.size();
+        size_t point = first_point;
+        for (size_t segment = first_segment; segment < last_segment; ++segment) {
+            size_t point_count = poly::Path::PointCount(path.segments_[segment]) + 1;
+            double x_points[4] = {}, y_points[4] = {};
+            for (size_t i = 0; i < point_count; ++i) {
+                x_points[i] = path.x_vec_[point + i];
+                y_points[i] = path.y_vec_[point + i];
+            }
+            AddSegment(x_points, y_points, point_count);
+            point += point_count - 1;
+        }
+
+        // Close the contour with a line back to its start.
+        if (path.x_vec_[point] != path.x_vec_[first_point] || path.y_vec_[point] != path.y_vec_[first_point]) {
+            double x_points[4] = {path.x_vec_[point], path.x_vec_[first_point]};
+            double y_points[4] = {path.y_vec_[point], path.y_vec_[first_point]};
+            AddSegment(x_points, y_points, 2);
+        }
+    }
+}
+
+void PathWindingNumber::AddSegment(const double (&x_points)[4], const double (&y_points)[4], size_t point_count) {
+    if (point_count == 2) {
+        float start_x = float(x_points[0]), start_y = float(y_points[0]);
+        float end_x = float(x_points[1]), end_y = float(y_points[1]);
+        float min_y = std::min(start_y, end_y), max_y = std::max(start_y, end_y);
+        pieces_.push_back({true, start_x, start_y, end_x, end_y, min_y, max_y, {}, {}});
+        return;
+    }
+
+    double x_coefficients[4], y_coefficients[4];
+    PowerBasis(x_points, point_count, x_coefficients);
+    PowerBasis(y_points, point_count, y_coefficients);
+
+    std::vector<double> splits = {0};
+    AppendTurningPoints(x_coefficients, splits);
+    splits.push_back(1);
+
+    float start_x = float(x_points[0]), start_y = float(y_points[0]);
+    for (size_t i = 0; i + 1 < splits.size(); ++i) {
+        Piece piece = {false, start_x, start_y, 0.f, 0.f, 0.f, 0.f, {}, {}};
+        bool last = (i + 2 == splits.size());
+        piece.end_x = last ? float(x_points[point_count - 1]) : float(Evaluate(x_coefficients, splits[i + 1]));
+        piece.end_y = last ? float(y_points[point_count - 1]) : float(Evaluate(y_coefficients, splits[i + 1]));
+        Reparameterize(x_coefficients, splits[i], splits[i + 1], piece.x_coefficients);
+        Reparameterize(y_coefficients, splits[i], splits[i + 1], piece.y_coefficients);
+
+        // The piece's y-range spans its end points and any turning points in y between them.
+        piece.min_y = std::min(piece.start_y, piece.end_y);
+        piece.max_y = std::max(piece.start_y, piece.end_y);
+        std::vector<double> turning_points;
+        AppendTurningPoints(piece.y_coefficients, turning_points);
+        for (double t : turning_points) {
+            float turning_y = float(Evaluate(piece.y_coefficients, t));
+            piece.min_y = std::min(piece.min_y, turning_y);
+            piece.max_y = std::max(piece.max_y, turning_y);
+        }
+
+        pieces_.push_back(piece);
+        start_x = piece.end_x;
+        start_y = piece.end_y;
+    }
+}
+
+int PathWindingNumber::PieceContribution(const Piece& piece, float x, float y) const {
+    if (piece.is_line) {
+        return EdgeContribution({piece.start_x, piece.start_y}, {piece.end_x, piece.end_y}, {x, y});
+    }
+
+    // As with line segments, only pieces with start.x <= x < end.x (or the reverse) cross the ray.
+    bool start_left_or_on = piece.start_x <= x;
+    if (start_left_or_on == (piece.end_x <= x) || piece.max_y < y) {
+        return 0;
+    }
+    // Left to right motion above the point is clockwise, right to left is counter-clockwise and includes the point
+    // being on the curve.
+    int contribution = start_left_or_on ? -1 : 1;
+    if (piece.min_y > y) {
+        return contribution;
+    }
+
+    // Find where the piece crosses the ray: Newton's method, falling back to bisection when it leaves the bracket.
+    double low = 0, high = 1;
+    bool increasing = piece.start_x < piece.end_x;
+    double t = (double(x) - piece.start_x) / (double(piece.end_x) - piece.start_x);
+    for (int iteration = 0; iteration < 64 && high - low > 1e-12; ++iteration) {
+        double error = Evaluate(piece.x_coefficients, t) - x;
+        if (error == 0) break;
+        if ((error < 0) == increasing) {
+            low = t;
+        } else {
+            high = t;
+        }
+        double slope = Derivative(piece.x_coefficients, t);
+        double next = (slope != 0) ? t - error / slope : low - 1;
+        t = (next > low && next < high) ? next : 0.5 * (low + high);
+    }
+    float crossing_y = float(Evaluate(piece.y_coefficients, t));
+    if (start_left_or_on) {
+        return crossing_y > y ? contribution : 0;
+    }
+    return crossing_y >= y ? contribution : 0;
+}
+
+int PathWindingNumber::CalculateWindingNumber2D(float x, float y) const {
+    int winding_number = 0;
+    for (const Piece& piece : pieces_) {
+        winding_number += PieceContribution(piece, x, y);
+    }
+    return winding_number;
+}
+
+size_t PathWindingNumber::piece_count() const noexcept {
+    return pieces_.size();
+}
+
+}  // namespace winding_number
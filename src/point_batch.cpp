@@ -0,0 +1,148 @@
+#include <point_batch.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include "cache_internal.hpp"
+#include "simd_internal.hpp"
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeContribution;
+
+#if defined(WINDING_NUMBER_SIMD)
+using internal::AddEdgeContribution;
+using internal::Broadcast;
+using internal::FloatLanes;
+using internal::IntLanes;
+using internal::kLanes;
+
+// Lane groups evaluated per edge visit. Two groups hide the latency of one edge's dependent operations behind the
+// other's, more of them run out of registers on baseline x86-64.
+constexpr size_t kGroups = 2;
+constexpr size_t kBlockSize = kGroups * kLanes;
+#else
+constexpr size_t kBlockSize = 1;
+#endif
+
+struct Tiles {
+    size_t edges;   // Edges per tile, their vertices fill half of the L1 data cache.
+    size_t points;  // Points per tile, a multiple of kBlockSize whose coordinates and counters fill half of L2.
+};
+
+const Tiles& TileSizes() {
+    static const Tiles tiles = [] {
+        const internal::CacheSizes& caches = internal::DetectCacheSizes();
+        size_t edges = std::max<size_t>(64, caches.l1_data / 2 / (2 * sizeof(float)));
+        size_t points = caches.l2 / 2 / (2 * sizeof(float) + sizeof(int)) / kBlockSize * kBlockSize;
+        return Tiles{edges, std::max(points, kBlockSize)};
+    }();
+    return tiles;
+}
+
+#if defined(WINDING_NUMBER_SIMD)
+// Adds the contributions of the edges between vertices first and last of the polygon to the winding numbers of
+// kBlockSize points.
+template <typename View>
+void AccumulateBlock(const View& polygon, size_t first, size_t last, const float* x, const float* y,
+                     int* winding_numbers) {
+    FloatLanes px[kGroups], py[kGroups];
+    IntLanes sum[kGroups];
+    for (size_t group = 0; group < kGroups; ++group) {
+        internal::Load(x + group * kLanes, px[group]);
+        internal::Load(y + group * kLanes, py[group]);
+        internal::Load(winding_numbers + group * kLanes, sum[group]);
+    }
+    FloatLanes ax, ay, bx, by;
+    Broadcast(polygon.x(first), ax);
+    Broadcast(polygon.y(first), ay);
+    for (size_t i = first + 1; i <= last; ++i) {
+        Broadcast(polygon.x(i), bx);
+        Broadcast(polygon.y(i), by);
+        for (size_t group = 0; group < kGroups; ++group) {
+            AddEdgeContribution(ax, ay, bx, by, px[group], py[group], sum[group]);
+        }
+        ax = bx;
+        ay = by;
+    }
+    for (size_t group = 0; group < kGroups; ++group) {
+        internal::Store(sum[group], winding_numbers + group * kLanes);
+    }
+}
+
+// Winding numbers of count points, a multiple of kBlockSize. Polygons whose vertices do not fit in the L1 cache are
+// walked a tile at a time, and every block of a tile of points is run against a tile of edges before moving on to the
+// next, so that the edges are read from L1 and the points and their counters from L2 instead of memory.
+template <typename View>
+void TiledWindingNumbers(const View& polygon, const float* x, const float* y, size_t count,
+                         int* winding_numbers) {
+    const Tiles& tiles = TileSizes();
+    size_t edge_count = polygon.size() - 1;
+    std::fill(winding_numbers, winding_numbers + count, 0);
+    for (size_t point_tile = 0; point_tile < count; point_tile += tiles.points) {
+        size_t point_tile_end = std::min(count, point_tile + tiles.points);
+        for (size_t edge_tile = 0; edge_tile < edge_count; edge_tile += tiles.edges) {
+            size_t edge_tile_end = std::min(edge_count, edge_tile + tiles.edges);
+            for (size_t i = point_tile; i < point_tile_end; i += kBlockSize) {
+                AccumulateBlock(polygon, edge_tile, edge_tile_end, x + i, y + i, winding_numbers + i);
+            }
+        }
+    }
+}
+#endif
+}  // namespace
+
+PointBatchPolygon::PointBatchPolygon(poly::Polygon polygon, poly::VertexLayout layout) :
+        vertices_(std::move(polygon), layout) {}
+
+int PointBatchPolygon::CalculateWindingNumber2D(float x, float y) const {
+    return vertices_.Visit([x, y](const auto& view) { return internal::ScanWindingNumber(view, {x, y}); });
+}
+
+void PointBatchPolygon::CalculateWindingNumbers2D(const float* x, const float* y, size_t count,
+                                                  int* winding_numbers) const {
+    size_t i = 0;
+#if defined(WINDING_NUMBER_SIMD)
+    i = count - count % kBlockSize;
+    vertices_.Visit([&](const auto& view) {
+        TiledWindingNumbers(view, x, y, i, winding_numbers);
+        // The last partial block is padded with copies of its first point rather than scanned one point at a time.
+        if (i < count) {
+            float block_x[kBlockSize], block_y[kBlockSize];
+            int block_winding_numbers[kBlockSize] = {};
+            std::fill(std::copy(x + i, x + count, block_x), block_x + kBlockSize, x[i]);
+            std::fill(std::copy(y + i, y + count, block_y), block_y + kBlockSize, y[i]);
+            AccumulateBlock(view, 0, view.size() - 1, block_x, block_y, block_winding_numbers);
+            std::copy(block_winding_numbers, block_winding_numbers + (count - i), winding_numbers + i);
+        }
+    });
+    i = count;
+#endif
+    for (; i < count; ++i) {
+        winding_numbers[i] = CalculateWindingNumber2D(x[i], y[i]);
+    }
+}
+
+Engine PointBatchPolygon::engine() const noexcept {
+    return Engine::kPointBatch;
+}
+
+poly::VertexLayout PointBatchPolygon::layout() const noexcept {
+    return vertices_.layout();
+}
+
+size_t PointBatchPolygon::block_size() noexcept {
+    return kBlockSize;
+}
+
+size_t PointBatchPolygon::edge_tile_size() noexcept {
+    return TileSizes().edges;
+}
+
+size_t PointBatchPolygon::point_tile_size() noexcept {
+    return TileSizes().points;
+}
+
+}  // namespace winding_number
@@ -1,125 +1,474 @@
 #include <poly_io.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
 #include <cmath>
+#include <exception>
 #include <filesystem>  // A C++17 capable compiler is assumed here.
-#include <fstream>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
+
+#include "decompress_internal.hpp"
+#include "mapped_file_internal.hpp"
+#include "structural_scan_internal.hpp"
 
 namespace poly {
 namespace {
 
-    // Split a string in to separate strings, separated by any of the passed in delimeters (each is a character).
-    std::vector<std::string_view> SplitString(std::string_view to_split, std::string_view delims) {
-        std::vector<std::string_view> split_strings;
+    // Use horizontal tabs for white space delimiting as well.
+    constexpr std::string_view kDelimiters = " \t";
+
+    // Parses the longest prefix of token that reads as a float, the way std::stof does: leading white space and a
+    // leading '+' are skipped, hexadecimal values need a 0x prefix, and trailing characters such as the 'f' of "5.f"
+    // or the '\r' of a CRLF line are ignored. Unlike std::stof this neither allocates, throws nor depends on the
+    // locale.
+    //
+    // Returns the error when no prefix of the token is a float, or when its value does not fit in one.
+    std::optional<ParseErrorKind> ParseFloat(std::string_view token, float& value) {
+        const char* first = token.data();
+        const char* last = token.data() + token.size();
+        while (first != last && (*first == ' ' || ('\t' <= *first && *first <= '\r'))) {
+            ++first;
+        }
+        bool negative = false;
+        if (first != last && (*first == '+' || *first == '-')) {
+            negative = *first == '-';
+            ++first;
+        }
+        auto format = std::chars_format::general;
+        if (last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) {
+            format = std::chars_format::hex;
+            first += 2;
+        }
+        // std::from_chars() takes a leading '-' itself, so one after the sign that was already consumed has to be
+        // rejected here.
+        std::errc error = std::errc::invalid_argument;
+        if (first != last && *first != '+' && *first != '-') {
+            error = std::from_chars(first, last, value, format).ec;
+        }
+        if (error == std::errc::invalid_argument) {
+            return ParseErrorKind::kNotAFloat;
+        } else if (error == std::errc::result_out_of_range) {
+            return ParseErrorKind::kOutOfRange;
+        }
+        value = negative ? -value : value;
+        return std::nullopt;
+    }
+
+    // A line that could not be parsed, with the offset in the line of the token at fault.
+    struct LineFailure {
+        ParseErrorKind kind;
+        size_t offset;
+    };
+
+    // Assembles a point and a polygon from the tokens of a line in the format of
+    // IPolygonReader::CreatePointAndPolygonFromString(), fed to it one at a time by either of the tokenizers below. The
+    // polygon's previous vertices are dropped on Reset() but its storage is kept, so that reusing it allocates only for
+    // a line with more vertices than any before it.
+    class RecordBuilder {
+    public:
+        explicit RecordBuilder(Polygon& polygon) : polygon_(polygon) { Reset(); }
+
+        void Reset() {
+            polygon_.x_vec_.clear();
+            polygon_.y_vec_.clear();
+            value_count_ = 0;
+            failure_.reset();
+        }
+
+        // Takes the next token of the line, offset being where it starts in the line. Tokens after a failure are
+        // ignored, a line is reported by its first error.
+        void AddToken(size_t offset, std::string_view token) {
+            float value = 0.f;
+            if (failure_) {
+                return;
+            } else if (auto error = ParseFloat(token, value)) {
+                failure_ = LineFailure{*error, offset};
+            } else if (value_count_ == 0) {
+                point_x_ = value;
+            } else if (value_count_ == 1) {
+                point_y_ = value;
+            } else if (value_count_ % 2 == 0) {
+                x_ = value;
+            } else {
+                polygon_.AppendPoint(x_, value);
+            }
+            ++value_count_;
+        }
+
+        // Whether the line had no tokens, being blank or only a comment. Files skip such lines without a diagnostic,
+        // only a single line passed to CreatePointAndPolygonFromString() is an error when it is empty.
+        bool empty() const { return value_count_ == 0 && !failure_; }
+
+        // Ends the line, storing its point in x_out and y_out unless it failed.
+        std::optional<LineFailure> Finish(float& x_out, float& y_out) const {
+            if (failure_) {
+                return failure_;
+            } else if (value_count_ == 0) {
+                return LineFailure{ParseErrorKind::kMissingPointX, 0};
+            } else if (value_count_ == 1) {
+                return LineFailure{ParseErrorKind::kMissingPointY, 0};
+            }
 
-        for (size_t first = 0, second = 0; first < to_split.size() && second != std::string_view::npos;
-             first = second + 1) {
-            second = to_split.find_first_of(delims, first);
-            if (first != second) {
-                split_strings.emplace_back(to_split.substr(first, second - first));
+            // Post-submission addition.
+            if (polygon_.size() <= 1) {
+                return LineFailure{ParseErrorKind::kInsufficientGeometry, 0};
             }
+            x_out = point_x_;
+            y_out = point_y_;
+            return std::nullopt;
+        }
+
+    private:
+        Polygon& polygon_;
+        size_t value_count_ = 0;
+        float point_x_ = 0.f;
+        float point_y_ = 0.f;
+        float x_ = 0.f;
+        std::optional<LineFailure> failure_;
+    };
+
+    // Parses a single line into a point and a polygon, splitting it with plain string searches. Whole files go through
+    // internal::ForEachToken() instead, which tokenizes many lines at once.
+    std::optional<LineFailure> ParsePointAndPolygon(std::string_view polygon_string, float& x_out, float& y_out,
+                                                    Polygon& polygon) {
+        // Permit trailing comments, setting # as the formal comment character.
+        std::string_view line_body = polygon_string.substr(0, polygon_string.find('#'));
+
+        RecordBuilder record(polygon);
+        for (size_t first = line_body.find_first_not_of(kDelimiters); first != std::string_view::npos;
+             first = line_body.find_first_not_of(kDelimiters, first)) {
+            size_t second = std::min(line_body.find_first_of(kDelimiters, first), line_body.size());
+            record.AddToken(first, line_body.substr(first, second - first));
+            first = second;
         }
-        return split_strings;
+        return record.Finish(x_out, y_out);
     }
 
+    // The message that the throwing API reports for a parse error, token being the text at the error's offset.
+    std::string ErrorMessage(ParseErrorKind kind, std::string_view token) {
+        token = token.substr(0, std::min(token.find_first_of(kDelimiters), token.find('#')));
+        switch (kind) {
+        case ParseErrorKind::kNotAFloat:
+            return "Could not parse line because this is not a floating point value: " + std::string(token);
+        case ParseErrorKind::kOutOfRange:
+            return "Could not parse line because this is too large to fit in a float: " + std::string(token);
+        case ParseErrorKind::kMissingPointX:
+            return "Missing initial x-value for point.";
+        case ParseErrorKind::kMissingPointY:
+            return "Missing initial y-value for point.";
+        case ParseErrorKind::kLineTooLong:
+            return "Could not parse line because it is longer than the reader's line length limit.";
+        case ParseErrorKind::kInsufficientGeometry:
+            break;
+        }
+        return "Insufficient geometry to compose polygon.";
+    }
+
+    // Files are not split into ranges smaller than this, starting a thread costs more than parsing them.
+    constexpr size_t kMinBytesPerThread = 1 << 16;
+
+    // A streaming read hands the pages it has parsed back to the kernel every this many bytes, so that its resident
+    // size stays bounded however large the file is.
+    constexpr size_t kReleaseInterval = size_t(1) << 26;
+
     class DefaultPolygonReader : public IPolygonReader {
     public:
         std::tuple<float, float, Polygon> CreatePointAndPolygonFromString(std::string_view polygon_string) override;
         std::vector<std::tuple<float, float, Polygon>> ReadPointsAndPolygonsFromFile(
                 std::string_view filepath) override;
+        std::vector<std::tuple<float, float, Polygon>> ReadPointsAndPolygonsFromFile(
+                std::string_view filepath, size_t thread_count, std::vector<LineError>* line_errors) override;
+        ParseResult ParsePointsAndPolygonsFromFile(std::string_view filepath, ErrorPolicy policy,
+                                                   size_t thread_count) override;
+        size_t ForEachPointAndPolygonInFile(std::string_view filepath, const RecordVisitor& visitor,
+                                            std::vector<LineError>* line_errors) override;
+        size_t max_line_bytes() const noexcept override;
+        void max_line_bytes(size_t max_line_bytes) noexcept override;
+
+    private:
+        // Parses a mapped file, decompressing it first if it is compressed. Diagnostics are also recorded as messages in
+        // line_errors when it is given.
+        ParseResult ParseFile(internal::MappedFile& file, ErrorPolicy policy, size_t thread_count,
+                              std::vector<LineError>* line_errors);
+        // Parses uncompressed contents split over thread_count threads.
+        ParseResult ParseContents(std::string_view contents, ErrorPolicy policy, size_t thread_count,
+                                  std::vector<LineError>* line_errors);
+        // Parses the blocks of a decompressed file as they arrive.
+        ParseResult ParseStream(internal::DecompressedStream& stream, ErrorPolicy policy,
+                                std::vector<LineError>* line_errors);
+
+        size_t max_line_bytes_ = 0;
+    };
+
+    // The points and polygons parsed from a range of whole lines, along with diagnostics for the lines that failed,
+    // whose line numbers and byte offsets count from 0 at the start of the range.
+    struct ParsedRange {
+        ParseResult result;
+        size_t line_count = 0;
     };
 
+    // Ends a line of a file, which unlike a single line may be too long, 0 meaning no limit, and holds no record when
+    // it is blank or a comment.
+    std::optional<LineFailure> FinishLine(RecordBuilder& record, std::string_view line, size_t max_line_bytes,
+                                          float& x_out, float& y_out, bool& has_record) {
+        has_record = false;
+        if (max_line_bytes != 0 && line.size() > max_line_bytes) {
+            return LineFailure{ParseErrorKind::kLineTooLong, 0};
+        } else if (record.empty()) {
+            return std::nullopt;
+        }
+        auto failure = record.Finish(x_out, y_out);
+        has_record = !failure;
+        return failure;
+    }
+
+    ParsedRange ParseRange(std::string_view text, ErrorPolicy policy, size_t max_line_bytes) {
+        ParsedRange range;
+        float x = 0.f, y = 0.f;
+        bool has_record = false;
+        Polygon polygon;
+        RecordBuilder record(polygon);
+        auto add_token = [&](size_t offset, std::string_view token) { record.AddToken(offset, token); };
+        internal::ForEachToken(text, add_token, [&](std::string_view line) {
+            if (auto failure = FinishLine(record, line, max_line_bytes, x, y, has_record)) {
+                // failed to parse line - toss & move on.
+                if (policy != ErrorPolicy::kSkip) {
+                    uint64_t byte_offset = uint64_t(line.data() - text.data()) + failure->offset;
+                    range.result.diagnostics.push_back({range.line_count, byte_offset, failure->kind});
+                }
+                if (policy == ErrorPolicy::kStop) {
+                    range.result.stopped = true;
+                    return false;
+                }
+            } else if (has_record) {
+                range.result.point_and_polygons.emplace_back(x, y, polygon);
+            }
+            record.Reset();
+            ++range.line_count;
+            return true;
+        });
+        return range;
+    }
+
+    // Appends a range parsed from text to result, numbering its lines from first_line and its bytes from first_byte.
+    void AppendRange(ParseResult& result, ParsedRange& range, std::string_view text, size_t first_line,
+                     uint64_t first_byte, std::vector<LineError>* line_errors) {
+        auto& records = range.result.point_and_polygons;
+        if (result.point_and_polygons.empty()) {
+            result.point_and_polygons = std::move(records);
+        } else {
+            std::move(records.begin(), records.end(), std::back_inserter(result.point_and_polygons));
+        }
+        for (const auto& diagnostic : range.result.diagnostics) {
+            result.diagnostics.push_back(
+                    {first_line + diagnostic.line, first_byte + diagnostic.byte_offset, diagnostic.kind});
+            if (line_errors) {
+                std::string_view token = text.substr(size_t(diagnostic.byte_offset));
+                std::string message = ErrorMessage(diagnostic.kind, token);
+                line_errors->push_back({first_line + size_t(diagnostic.line), std::move(message)});
+            }
+        }
+        result.stopped = range.result.stopped;
+    }
+
     std::tuple<float, float, Polygon> DefaultPolygonReader::CreatePointAndPolygonFromString(
             std::string_view polygon_string) {
+        float x = 0.f, y = 0.f;
+        Polygon polygon;
+        if (auto failure = ParsePointAndPolygon(polygon_string, x, y, polygon)) {
+            throw std::runtime_error(ErrorMessage(failure->kind, polygon_string.substr(failure->offset)));
+        }
+        return {x, y, std::move(polygon)};
+    }
 
-        // Permit trailing comments, setting # as the formal comment character.
-        std::string_view line_body = polygon_string.substr(0, polygon_string.find('#'));
+    std::vector<std::tuple<float, float, Polygon>> DefaultPolygonReader::ReadPointsAndPolygonsFromFile(
+            std::string_view filepath) {
+        return ReadPointsAndPolygonsFromFile(filepath, 1, nullptr);
+    }
+
+    std::vector<std::tuple<float, float, Polygon>> DefaultPolygonReader::ReadPointsAndPolygonsFromFile(
+            std::string_view filepath, size_t thread_count, std::vector<LineError>* line_errors) {
+        std::filesystem::path path(filepath);
+        if (!std::filesystem::exists(path) || !std::filesystem::is_regular_file(path)) {
+            throw std::runtime_error("Provided filepath is not readable as a file: " + std::string(filepath));
+        }
+        try {
+            // Lines are parsed in place in the mapped file, the only copies made are the parsed coordinates.
+            internal::MappedFile file{std::string(filepath)};
+            ErrorPolicy policy = line_errors ? ErrorPolicy::kCollect : ErrorPolicy::kSkip;
+            return std::move(ParseFile(file, policy, thread_count, line_errors).point_and_polygons);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Failed to read:\t" + std::string(filepath) + "\n" +  //
+                                     "Error:\t\t" + e.what());
+        }
+    }
 
-        // Use horizontal tabs for white space delimiting as well.
-        auto split_string = SplitString(line_body, " \t");
+    ParseResult DefaultPolygonReader::ParsePointsAndPolygonsFromFile(std::string_view filepath, ErrorPolicy policy,
+                                                                     size_t thread_count) {
+        std::filesystem::path path(filepath);
+        if (!std::filesystem::exists(path) || !std::filesystem::is_regular_file(path)) {
+            throw std::runtime_error("Provided filepath is not readable as a file: " + std::string(filepath));
+        }
+        try {
+            internal::MappedFile file{std::string(filepath)};
+            return ParseFile(file, policy, thread_count, nullptr);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Failed to read:\t" + std::string(filepath) + "\n" +  //
+                                     "Error:\t\t" + e.what());
+        }
+    }
 
-        std::optional<float> x, point_x, point_y;
-        std::string element_string;
-        Polygon polygon;
-        for (std::string_view element_view : split_string) {
-            element_string = element_view;
-            float element_value;
+    ParseResult DefaultPolygonReader::ParseFile(internal::MappedFile& file, ErrorPolicy policy, size_t thread_count,
+                                                std::vector<LineError>* line_errors) {
+        internal::Compression compression = internal::DetectCompression(file.contents());
+        if (compression == internal::Compression::kNone) {
+            return ParseContents(file.contents(), policy, thread_count, line_errors);
+        }
+        internal::DecompressedStream stream(file, compression, max_line_bytes_);
+        return ParseStream(stream, policy, line_errors);
+    }
+
+    ParseResult DefaultPolygonReader::ParseContents(std::string_view contents, ErrorPolicy policy,
+                                                    size_t thread_count, std::vector<LineError>* line_errors) {
+        // Cut the file into ranges of about equal size, each moved forward to start just past a newline so that every
+        // line falls in exactly one range.
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_count = std::max<size_t>(1, std::min(thread_count, contents.size() / kMinBytesPerThread));
+        std::vector<size_t> bounds = {0};
+        for (size_t i = 1; i < thread_count; ++i) {
+            size_t bound = std::max(bounds.back(), contents.size() / thread_count * i);
+            size_t newline = contents.find('\n', bound - 1);
+            bounds.push_back(newline == std::string_view::npos ? contents.size() : newline + 1);
+        }
+        bounds.push_back(contents.size());
+
+        std::vector<ParsedRange> ranges(thread_count);
+        std::vector<std::exception_ptr> failures(thread_count);
+        auto parse = [&](size_t i) {
             try {
-                element_value = std::stof(element_string);
-            } catch (const std::invalid_argument&) {
-                throw std::runtime_error("Could not parse line because this is not a floating point value: " +
-                                         element_string);
-            } catch (const std::out_of_range&) {
-                throw std::runtime_error("Could not parse line because this is too large to fit in a float: " +
-                                         element_string);
-            }
-            if (!point_x) {
-                point_x = element_value;
-            } else if (!point_y) {
-                point_y = element_value;
-            } else if (!x) {
-                x = element_value;
-            } else {
-                polygon.AppendPoint(*x, element_value);
-                x.reset();
+                ranges[i] = ParseRange(contents.substr(bounds[i], bounds[i + 1] - bounds[i]), policy, max_line_bytes_);
+            } catch (...) {
+                failures[i] = std::current_exception();
             }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count - 1);
+        for (size_t i = 1; i < thread_count; ++i) {
+            workers.emplace_back(parse, i);
         }
-        if (!point_x) {
-            throw std::runtime_error("Missing initial x-value for point.");
-        } else if (!point_y) {
-            throw std::runtime_error("Missing initial y-value for point.");
+        parse(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& failure : failures) {
+            if (failure) std::rethrow_exception(failure);
         }
 
-        // Post-submission addition.
-        if (polygon.size() <= 1) {
-            throw std::runtime_error("Insufficient geometry to compose polygon.");
+        // Concatenate in file order, numbering lines from the ranges' offsets. A stop in one range discards the
+        // ranges after it, which were parsed speculatively.
+        ParseResult result;
+        size_t first_line = 1;
+        for (size_t i = 0; i < thread_count && !result.stopped; ++i) {
+            std::string_view text = contents.substr(bounds[i], bounds[i + 1] - bounds[i]);
+            AppendRange(result, ranges[i], text, first_line, bounds[i], line_errors);
+            first_line += ranges[i].line_count;
         }
-        return {*point_x, *point_y, polygon};
+        return result;
     }
 
-    std::vector<std::tuple<float, float, Polygon>> DefaultPolygonReader::ReadPointsAndPolygonsFromFile(
-            std::string_view filepath) {
+    ParseResult DefaultPolygonReader::ParseStream(internal::DecompressedStream& stream, ErrorPolicy policy,
+                                                  std::vector<LineError>* line_errors) {
+        // Blocks are parsed on this thread while the next ones are decompressed.
+        ParseResult result;
+        size_t first_line = 1;
+        uint64_t first_byte = 0;
+        for (std::string_view block = stream.NextBlock(); !block.empty() && !result.stopped;
+             block = stream.NextBlock()) {
+            ParsedRange range = ParseRange(block, policy, max_line_bytes_);
+            AppendRange(result, range, block, first_line, first_byte, line_errors);
+            first_line += range.line_count;
+            first_byte += block.size() + stream.skipped_bytes();
+        }
+        return result;
+    }
+
+    size_t DefaultPolygonReader::ForEachPointAndPolygonInFile(std::string_view filepath, const RecordVisitor& visitor,
+                                                              std::vector<LineError>* line_errors) {
         std::filesystem::path path(filepath);
         if (!std::filesystem::exists(path) || !std::filesystem::is_regular_file(path)) {
             throw std::runtime_error("Provided filepath is not readable as a file: " + std::string(filepath));
         }
-        std::vector<std::tuple<float, float, Polygon>> point_and_polygons;
-        std::string line;
-        std::ifstream fs;
-        int i = 0;
+        size_t record_count = 0;
+        size_t line_number = 0;
+        size_t released = 0;
+        float x = 0.f, y = 0.f;
+        bool has_record = false;
+        Polygon polygon;
+        RecordBuilder record(polygon);
+        auto add_token = [&](size_t offset, std::string_view token) { record.AddToken(offset, token); };
         try {
-            fs = std::ifstream(std::string(filepath), std::ios::in);
-            fs.exceptions(fs.failbit | fs.badbit);
-
-            // SD: Interestingly, merely peeking for EOF is insufficient - if the stream has already reached EOF
-            //     then peeking for it may trip the failbit and throw an exception (due to the above exception
-            //     mask) This can be fixed by shortcircuiting if eofbit is already set. Another thing to do - which
-            //     may be better overall is to use fs.good() to ensure the stream is still in a usable state overall.
-            while (!fs.eof() && fs.peek() != std::char_traits<char>::eof()) {
-                std::getline(fs, line);
-                try {
-                    point_and_polygons.emplace_back(CreatePointAndPolygonFromString(line));
-                } catch (const std::runtime_error&) {
+            auto end_line = [&](std::string_view line) {
+                ++line_number;
+                bool keep_reading = true;
+                if (auto failure = FinishLine(record, line, max_line_bytes_, x, y, has_record)) {
                     // failed to parse line - toss & move on.
-                    continue;
+                    if (line_errors) {
+                        std::string message = ErrorMessage(failure->kind, line.substr(failure->offset));
+                        line_errors->push_back({line_number, std::move(message)});
+                    }
+                } else if (has_record) {
+                    ++record_count;
+                    keep_reading = visitor(x, y, polygon);
+                }
+                record.Reset();
+                return keep_reading;
+            };
+
+            internal::MappedFile file{std::string(filepath)};
+            std::string_view contents = file.contents();
+            internal::Compression compression = internal::DetectCompression(contents);
+            if (compression == internal::Compression::kNone) {
+                internal::ForEachToken(contents, add_token, [&](std::string_view line) {
+                    size_t offset = size_t(line.data() - contents.data());
+                    if (offset - released >= kReleaseInterval) {
+                        file.Release(released, offset);
+                        released = offset;
+                    }
+                    return end_line(line);
+                });
+            } else {
+                // The stream releases the compressed input itself, and records reach the visitor block by block as
+                // they are decompressed.
+                internal::DecompressedStream stream(file, compression, max_line_bytes_);
+                for (std::string_view block = stream.NextBlock(); !block.empty(); block = stream.NextBlock()) {
+                    if (!internal::ForEachToken(block, add_token, end_line)) {
+                        break;
+                    }
                 }
             }
-        } catch (const std::ios_base::failure& e) {
-            fs.close();
-            throw std::runtime_error("Failed to read:\t" + std::string(filepath) + "\n" +  //
-                                     "Error:\t\t" + e.what());
         } catch (const std::runtime_error& e) {
-            fs.close();
-            throw std::runtime_error("Failed to read a line in:\t" + std::string(filepath) + "\n" +  //
+            throw std::runtime_error("Failed to read:\t" + std::string(filepath) + "\n" +  //
                                      "Error:\t\t" + e.what());
         }
-        fs.close();
-        return point_and_polygons;
+        return record_count;
+    }
+
+    size_t DefaultPolygonReader::max_line_bytes() const noexcept {
+        return max_line_bytes_;
+    }
+
+    void DefaultPolygonReader::max_line_bytes(size_t max_line_bytes) noexcept {
+        max_line_bytes_ = max_line_bytes;
     }
 
 }  // namespace
@@ -153,6 +502,14 @@ bool Polygon::IsClosed(float tolerance) const {
             std::abs(y_vec_.front() - y_vec_.back()) <= tolerance);
 }
 
+void PolygonSet::AppendPolygon(Polygon polygon) {
+    polygons_.push_back(std::move(polygon));
+}
+
+size_t PolygonSet::size() const {
+    return polygons_.size();
+}
+
 std::unique_ptr<IPolygonReader> IPolygonReader::Create() {
     return std::make_unique<DefaultPolygonReader>();
 }
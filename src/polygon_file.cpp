@@ -0,0 +1,235 @@
+#include <polygon_file.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+#include "mapped_file_internal.hpp"
+
+namespace poly {
+namespace {
+
+static_assert(sizeof(PolygonFileHeader) == 32, "the header layout is part of the file format");
+static_assert(sizeof(float) == 4, "vertex columns hold 32-bit floats");
+
+// Writes a binary file record by record, with the counts in its header known up front. Every column is written
+// sequentially through a stream of its own that starts at the column's offset, so memory use does not grow with the
+// size of the file.
+class ColumnWriter {
+public:
+    ColumnWriter(std::string_view binary_path, uint64_t record_count, uint64_t vertex_count) :
+            path_(binary_path), record_count_(record_count), vertex_count_(vertex_count) {
+        const uint32_t byte_order_test = 1;
+        uint8_t first_byte;
+        std::memcpy(&first_byte, &byte_order_test, 1);
+        if (first_byte != 1) {
+            throw std::runtime_error("Binary polygon files can only be written on little endian machines.");
+        }
+
+        PolygonFileHeader header = {};
+        std::memcpy(header.magic, PolygonFileHeader::kMagic, sizeof(header.magic));
+        header.version = PolygonFileHeader::kVersion;
+        header.byte_order_mark = PolygonFileHeader::kByteOrderMark;
+        header.record_count = record_count;
+        header.vertex_count = vertex_count;
+        {
+            std::ofstream fs(path_, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!fs.write(reinterpret_cast<const char*>(&header), sizeof(header))) {
+                throw std::runtime_error("Failed to open for writing:\t" + path_);
+            }
+        }
+
+        uint64_t offsets_size = (record_count + 1) * sizeof(uint64_t);
+        uint64_t points_size = record_count * sizeof(float);
+        uint64_t vertices_size = vertex_count * sizeof(float);
+        const uint64_t column_offsets[kColumnCount] = {
+                sizeof(header),
+                sizeof(header) + offsets_size,
+                sizeof(header) + offsets_size + points_size,
+                sizeof(header) + offsets_size + 2 * points_size,
+                sizeof(header) + offsets_size + 2 * points_size + vertices_size,
+        };
+        std::error_code error;
+        std::filesystem::resize_file(path_, column_offsets[kColumnCount - 1] + vertices_size, error);
+        if (error) {
+            throw std::runtime_error("Failed to write:\t" + path_ + "\nError:\t\t" + error.message());
+        }
+        for (size_t i = 0; i < kColumnCount; ++i) {
+            buffers_[i].resize(kBufferBytes);
+            columns_[i].rdbuf()->pubsetbuf(buffers_[i].data(), std::streamsize(kBufferBytes));
+            columns_[i].open(path_, std::ios::in | std::ios::out | std::ios::binary);
+            if (!columns_[i].seekp(std::streamoff(column_offsets[i]))) {
+                throw std::runtime_error("Failed to open for writing:\t" + path_);
+            }
+        }
+        WriteValues(kOffsets, &vertices_written_, 1);
+    }
+
+    void Append(float x, float y, const Polygon& polygon) {
+        ++records_written_;
+        vertices_written_ += polygon.size();
+        if (records_written_ > record_count_ || vertices_written_ > vertex_count_) {
+            throw std::runtime_error("Failed to write:\t" + path_ + "\nError:\t\tInput changed while it was read.");
+        }
+        WriteValues(kPointX, &x, 1);
+        WriteValues(kPointY, &y, 1);
+        WriteValues(kVertexX, polygon.x_vec_.data(), polygon.size());
+        WriteValues(kVertexY, polygon.y_vec_.data(), polygon.size());
+        WriteValues(kOffsets, &vertices_written_, 1);
+    }
+
+    void Finish() {
+        if (records_written_ != record_count_ || vertices_written_ != vertex_count_) {
+            throw std::runtime_error("Failed to write:\t" + path_ + "\nError:\t\tInput changed while it was read.");
+        }
+        for (auto& column : columns_) {
+            if (!column.flush()) {
+                throw std::runtime_error("Failed to write:\t" + path_);
+            }
+        }
+    }
+
+private:
+    enum Column { kOffsets, kPointX, kPointY, kVertexX, kVertexY, kColumnCount };
+
+    static constexpr size_t kBufferBytes = size_t(1) << 16;
+
+    template <typename T>
+    void WriteValues(Column column, const T* values, size_t count) {
+        columns_[column].write(reinterpret_cast<const char*>(values), std::streamsize(count * sizeof(T)));
+    }
+
+    std::string path_;
+    uint64_t record_count_, vertex_count_;
+    uint64_t records_written_ = 0, vertices_written_ = 0;
+    std::vector<char> buffers_[kColumnCount];
+    std::fstream columns_[kColumnCount];
+};
+
+std::runtime_error PolygonFileError(const std::string& path, const std::string& reason) {
+    return std::runtime_error("Failed to read:\t" + path + "\nError:\t\t" + reason);
+}
+
+}  // namespace
+
+size_t WritePolygonFile(IPolygonReader& reader, std::string_view text_path, std::string_view binary_path,
+                        std::vector<LineError>* line_errors) {
+    // The first pass sizes the columns, the second writes every record straight to its place in them.
+    uint64_t vertex_count = 0;
+    auto count = [&vertex_count](float, float, Polygon& polygon) {
+        vertex_count += polygon.size();
+        return true;
+    };
+    size_t record_count = reader.ForEachPointAndPolygonInFile(text_path, count);
+    ColumnWriter writer(binary_path, record_count, vertex_count);
+    reader.ForEachPointAndPolygonInFile(
+            text_path,
+            [&writer](float x, float y, Polygon& polygon) {
+                writer.Append(x, y, polygon);
+                return true;
+            },
+            line_errors);
+    writer.Finish();
+    return record_count;
+}
+
+void WritePolygonFile(const std::vector<std::tuple<float, float, Polygon>>& point_and_polygons,
+                      std::string_view binary_path) {
+    uint64_t vertex_count = 0;
+    for (const auto& point_and_polygon : point_and_polygons) {
+        vertex_count += std::get<2>(point_and_polygon).size();
+    }
+    ColumnWriter writer(binary_path, point_and_polygons.size(), vertex_count);
+    for (const auto& [x, y, polygon] : point_and_polygons) {
+        writer.Append(x, y, polygon);
+    }
+    writer.Finish();
+}
+
+PolygonFile::PolygonFile(std::string_view path) :
+        file_(std::make_unique<internal::MappedFile>(std::string(path))), path_(path) {
+    std::string_view contents = file_->contents();
+    auto fail = [this](const std::string& reason) { return PolygonFileError(path_, reason); };
+    PolygonFileHeader header;
+    if (contents.size() < sizeof(header)) {
+        throw fail("File is too short to be a binary polygon file.");
+    }
+    std::memcpy(&header, contents.data(), sizeof(header));
+    if (std::memcmp(header.magic, PolygonFileHeader::kMagic, sizeof(header.magic)) != 0) {
+        throw fail("File is not a binary polygon file.");
+    }
+    if (header.version != PolygonFileHeader::kVersion) {
+        throw fail("Unsupported binary polygon file version " + std::to_string(header.version) + ".");
+    }
+    if (header.byte_order_mark != PolygonFileHeader::kByteOrderMark) {
+        throw fail("Binary polygon file was written with a different byte order.");
+    }
+
+    // The counts are bounded before the expected size is computed, so that absurd counts in a corrupt header cannot
+    // overflow it.
+    uint64_t available = contents.size() - sizeof(header);
+    uint64_t records = header.record_count, vertices = header.vertex_count;
+    if (records >= available / sizeof(uint64_t) || vertices > available / (2 * sizeof(float))) {
+        throw fail("Binary polygon file is truncated or has trailing data.");
+    }
+    uint64_t expected = (records + 1) * sizeof(uint64_t) + (records + vertices) * 2 * sizeof(float);
+    if (available != expected) {
+        throw fail("Binary polygon file is truncated or has trailing data.");
+    }
+
+    const char* data = contents.data() + sizeof(header);
+    record_count_ = size_t(records);
+    vertex_offsets_ = reinterpret_cast<const uint64_t*>(data);
+    point_x_ = reinterpret_cast<const float*>(data + (records + 1) * sizeof(uint64_t));
+    point_y_ = point_x_ + records;
+    vertex_x_ = point_y_ + records;
+    vertex_y_ = vertex_x_ + vertices;
+}
+
+void PolygonFile::Validate() const {
+    size_t vertex_count = size_t(vertex_y_ - vertex_x_);
+    bool valid = vertex_offsets_[0] == 0 && vertex_offsets_[record_count_] == vertex_count;
+    for (size_t i = 0; valid && i < record_count_; ++i) {
+        valid = vertex_offsets_[i] <= vertex_offsets_[i + 1];
+    }
+    if (!valid) {
+        throw PolygonFileError(path_, "Binary polygon file has an inconsistent offsets table.");
+    }
+}
+
+PolygonFile::~PolygonFile() = default;
+
+size_t PolygonFile::size() const noexcept {
+    return record_count_;
+}
+
+float PolygonFile::point_x(size_t i) const noexcept {
+    return point_x_[i];
+}
+
+float PolygonFile::point_y(size_t i) const noexcept {
+    return point_y_[i];
+}
+
+PolygonView PolygonFile::polygon(size_t i) const noexcept {
+    size_t first = size_t(vertex_offsets_[i]);
+    return PolygonView(vertex_x_ + first, vertex_y_ + first, size_t(vertex_offsets_[i + 1]) - first);
+}
+
+const float* PolygonFile::point_x_data() const noexcept {
+    return point_x_;
+}
+
+const float* PolygonFile::point_y_data() const noexcept {
+    return point_y_;
+}
+
+const uint64_t* PolygonFile::vertex_offsets() const noexcept {
+    return vertex_offsets_;
+}
+
+}  // namespace poly
@@ -0,0 +1,50 @@
+#include <polygon_layout.hpp>
+
+#include <utility>
+
+namespace poly {
+namespace {
+
+template <typename Layout>
+void Store(const Polygon& polygon, std::vector<float>& data) {
+    data.assign(Layout::ArraySize(polygon.size()), 0.f);
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        data[Layout::XIndex(i)] = polygon.x_vec_[i];
+        data[Layout::YIndex(i)] = polygon.y_vec_[i];
+    }
+}
+
+}  // namespace
+
+VertexBuffer::VertexBuffer(const Polygon& polygon, VertexLayout layout) : layout_(layout), size_(polygon.size()) {
+    switch (layout) {
+    case VertexLayout::kSeparate:
+        x_vec_ = polygon.x_vec_;
+        y_vec_ = polygon.y_vec_;
+        break;
+    case VertexLayout::kInterleaved:
+        Store<InterleavedLayout>(polygon, x_vec_);
+        break;
+    case VertexLayout::kBlocked8:
+        Store<Blocked8Layout>(polygon, x_vec_);
+        break;
+    case VertexLayout::kBlocked16:
+        Store<Blocked16Layout>(polygon, x_vec_);
+        break;
+    }
+}
+
+VertexBuffer::VertexBuffer(Polygon&& polygon, VertexLayout layout) : layout_(layout), size_(polygon.size()) {
+    if (layout == VertexLayout::kSeparate) {
+        x_vec_ = std::move(polygon.x_vec_);
+        y_vec_ = std::move(polygon.y_vec_);
+    } else {
+        *this = VertexBuffer(static_cast<const Polygon&>(polygon), layout);
+    }
+}
+
+Polygon VertexBuffer::ToPolygon() const {
+    return Visit([](const auto& view) { return poly::ToPolygon(view); });
+}
+
+}  // namespace poly
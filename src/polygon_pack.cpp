@@ -0,0 +1,128 @@
+#include <polygon_pack.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "simd_internal.hpp"
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeContribution;
+using internal::Point;
+
+constexpr size_t kNoCandidate = SIZE_MAX;
+
+#if defined(WINDING_NUMBER_SIMD)
+static_assert(PolygonPack::kLanes == internal::kLanes, "a pack group fills exactly one lane group");
+#endif
+
+}  // namespace
+
+std::unique_ptr<PolygonPack> PolygonPack::Build(const poly::PolygonSet& polygons,
+                                                const std::vector<size_t>& candidates,
+                                                IWindingNumberAlgorithm& algorithm) {
+    std::vector<poly::Polygon> normalized;
+    normalized.reserve(candidates.size());
+    for (size_t candidate : candidates) {
+        auto result = algorithm.Normalize(polygons.polygons_[candidate]);
+        if (!result) {
+            return nullptr;
+        }
+        normalized.push_back(std::move(result->polygon));
+    }
+
+    // Grouping polygons of similar size keeps the padding down.
+    std::vector<size_t> order(candidates.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&normalized](size_t lhs, size_t rhs) {
+        return normalized[lhs].size() < normalized[rhs].size();
+    });
+
+    std::unique_ptr<PolygonPack> pack(new PolygonPack());
+    pack->size_ = candidates.size();
+    for (size_t first = 0; first < order.size(); first += kLanes) {
+        size_t last = std::min(order.size(), first + kLanes);
+        Group group = {pack->x_vec_.size() / kLanes, normalized[order[last - 1]].size()};
+        pack->x_vec_.resize((group.first_row + group.row_count) * kLanes, 0.f);
+        pack->y_vec_.resize((group.first_row + group.row_count) * kLanes, 0.f);
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            if (first + lane >= last) {
+                // Empty lanes keep their zero vertices, every edge of which is degenerate.
+                pack->lane_candidates_.push_back(kNoCandidate);
+                continue;
+            }
+            size_t candidate = order[first + lane];
+            const poly::Polygon& polygon = normalized[candidate];
+            for (size_t row = 0; row < group.row_count; ++row) {
+                size_t vertex = std::min(row, polygon.size() - 1);
+                pack->x_vec_[(group.first_row + row) * kLanes + lane] = polygon.x_vec_[vertex];
+                pack->y_vec_[(group.first_row + row) * kLanes + lane] = polygon.y_vec_[vertex];
+            }
+            pack->lane_candidates_.push_back(candidate);
+            pack->edge_count_ += polygon.size() - 1;
+        }
+        pack->groups_.push_back(group);
+    }
+    return pack;
+}
+
+void PolygonPack::CalculateWindingNumbers2D(float x, float y, int* winding_numbers) const {
+    for (size_t g = 0; g < groups_.size(); ++g) {
+        const Group& group = groups_[g];
+        const float* x_rows = x_vec_.data() + group.first_row * kLanes;
+        const float* y_rows = y_vec_.data() + group.first_row * kLanes;
+        int sums[kLanes] = {};
+#if defined(WINDING_NUMBER_SIMD)
+        internal::FloatLanes px, py, ax, ay, bx, by;
+        internal::Broadcast(x, px);
+        internal::Broadcast(y, py);
+        internal::IntLanes sum = {};
+        internal::Load(x_rows, ax);
+        internal::Load(y_rows, ay);
+        for (size_t row = 1; row < group.row_count; ++row) {
+            internal::Load(x_rows + row * kLanes, bx);
+            internal::Load(y_rows + row * kLanes, by);
+            internal::AddEdgeContribution(ax, ay, bx, by, px, py, sum);
+            ax = bx;
+            ay = by;
+        }
+        internal::Store(sum, sums);
+#else
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            for (size_t row = 1; row < group.row_count; ++row) {
+                Point a = {x_rows[(row - 1) * kLanes + lane], y_rows[(row - 1) * kLanes + lane]};
+                Point b = {x_rows[row * kLanes + lane], y_rows[row * kLanes + lane]};
+                sums[lane] += EdgeContribution(a, b, {x, y});
+            }
+        }
+#endif
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            size_t candidate = lane_candidates_[g * kLanes + lane];
+            if (candidate != kNoCandidate) {
+                winding_numbers[candidate] = sums[lane];
+            }
+        }
+    }
+}
+
+std::vector<int> PolygonPack::CalculateWindingNumbers2D(float x, float y) const {
+    std::vector<int> winding_numbers(size_);
+    CalculateWindingNumbers2D(x, y, winding_numbers.data());
+    return winding_numbers;
+}
+
+size_t PolygonPack::size() const noexcept {
+    return size_;
+}
+
+float PolygonPack::padding_fraction() const noexcept {
+    size_t slots = groups_.empty() ? 0 : (x_vec_.size() / kLanes - groups_.size()) * kLanes;
+    return slots == 0 ? 0.f : float(slots - edge_count_) / float(slots);
+}
+
+}  // namespace winding_number
@@ -0,0 +1,332 @@
+#include <convex.hpp>
+#include <edge_interval_tree.hpp>
+#include <hull_filter.hpp>
+#include <monotone_chain.hpp>
+#include <point_batch.hpp>
+#include <prepared.hpp>
+#include <quadtree.hpp>
+#include <rectilinear.hpp>
+#include <self_intersection.hpp>
+#include <star.hpp>
+#include <winding.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::ExtractPoint;
+using internal::FuzzyEquals;
+using internal::Point;
+using internal::ScanWindingNumber;
+using internal::WithinTolerance;
+
+// The set of directions, out of the anchor of a straight run, that the run's end point may take while every vertex
+// dropped so far stays within tolerance of the merged edge. Stored as its clockwise (right) and counter-clockwise
+// (left) boundary vectors, in double precision so that exactly collinear float input stays exactly collinear.
+struct RunCone {
+    bool bounded = false;
+    double right_x = 0, right_y = 0;
+    double left_x = 0, left_y = 0;
+};
+
+double Cross(double ax, double ay, double bx, double by) {
+    return ax * by - ay * bx;
+}
+
+// Distance of b from the line through a and c, or from a when a and c coincide.
+double DistanceFromLine(const Point& a, const Point& b, const Point& c) {
+    double dx = double(c.x) - a.x, dy = double(c.y) - a.y;
+    double length = std::hypot(dx, dy);
+    if (length == 0) {
+        return std::hypot(double(b.x) - a.x, double(b.y) - a.y);
+    }
+    return std::abs(Cross(dx, dy, double(b.x) - a.x, double(b.y) - a.y)) / length;
+}
+
+// Determines whether the run [a, b] may be extended to [a, c], dropping b, and if so narrows the cone accordingly.
+//
+// Vertical runs are never merged: SimpleWindingNumberAlgorithm counts a point sitting on the shared vertex of two
+// upward vertical edges once per edge, and merging them would change that answer.
+bool TryExtendRun(const Point& a, const Point& b, const Point& c, float tolerance, RunCone& cone) {
+    if (FuzzyEquals(a.x, b.x) || FuzzyEquals(b.x, c.x) || FuzzyEquals(a.x, c.x)) {
+        return false;
+    }
+    double ab_x = double(b.x) - a.x, ab_y = double(b.y) - a.y;
+    double bc_x = double(c.x) - b.x, bc_y = double(c.y) - b.y;
+    double ac_x = double(c.x) - a.x, ac_y = double(c.y) - a.y;
+
+    // Only a run that keeps moving forward can be merged, doubling back changes which points the edge passes over.
+    if (ab_x * bc_x + ab_y * bc_y <= 0) {
+        return false;
+    }
+
+    // Directions from a that keep b within tolerance of the merged edge.
+    double ab_length = std::hypot(ab_x, ab_y);
+    double sin_w = std::min(1.0, double(tolerance) / ab_length);
+    double cos_w = std::sqrt(1.0 - sin_w * sin_w);
+    RunCone narrowed;
+    narrowed.bounded = true;
+    narrowed.right_x = ab_x * cos_w + ab_y * sin_w;
+    narrowed.right_y = -ab_x * sin_w + ab_y * cos_w;
+    narrowed.left_x = ab_x * cos_w - ab_y * sin_w;
+    narrowed.left_y = ab_x * sin_w + ab_y * cos_w;
+    if (cone.bounded) {
+        if (Cross(narrowed.right_x, narrowed.right_y, cone.right_x, cone.right_y) > 0) {
+            narrowed.right_x = cone.right_x;
+            narrowed.right_y = cone.right_y;
+        }
+        if (Cross(narrowed.left_x, narrowed.left_y, cone.left_x, cone.left_y) < 0) {
+            narrowed.left_x = cone.left_x;
+            narrowed.left_y = cone.left_y;
+        }
+    }
+
+    if (Cross(narrowed.right_x, narrowed.right_y, ac_x, ac_y) < 0 ||
+        Cross(ac_x, ac_y, narrowed.left_x, narrowed.left_y) < 0) {
+        return false;
+    }
+    cone = narrowed;
+    return true;
+}
+
+// Removes vertices in the middle of straight runs from an open ring of vertices (the closing vertex is implied).
+std::vector<Point> MergeCollinearRuns(const std::vector<Point>& ring, float tolerance) {
+    size_t ring_size = ring.size();
+    if (ring_size < 3) {
+        return ring;
+    }
+
+    // Start from the sharpest corner so that the implied closing vertex is never the middle of a run.
+    size_t start = 0;
+    double sharpest = -1;
+    for (size_t i = 0; i < ring_size; ++i) {
+        double deviation = DistanceFromLine(ring[(i + ring_size - 1) % ring_size], ring[i], ring[(i + 1) % ring_size]);
+        if (deviation > sharpest) {
+            sharpest = deviation;
+            start = i;
+        }
+    }
+
+    std::vector<Point> merged;
+    merged.reserve(ring_size);
+    merged.push_back(ring[start]);
+    RunCone cone;
+    size_t run_end = 1;
+    for (size_t i = 2; i <= ring_size; ++i) {
+        const Point& b = ring[(start + run_end) % ring_size];
+        const Point& c = ring[(start + i) % ring_size];
+        if (!TryExtendRun(merged.back(), b, c, tolerance, cone)) {
+            merged.push_back(b);
+            cone = RunCone();
+        }
+        run_end = i;
+    }
+    return merged;
+}
+
+// An engine that simply walks every normalized edge, like SimpleWindingNumberAlgorithm but without having to check
+// for closure or skip degenerate edges on each query.
+class ScanPreparedPolygon : public IPreparedPolygon {
+public:
+    ScanPreparedPolygon(poly::Polygon polygon, poly::VertexLayout layout) : vertices_(std::move(polygon), layout) {}
+
+    int CalculateWindingNumber2D(float x, float y) const override {
+        return vertices_.Visit([x, y](const auto& view) { return ScanWindingNumber(view, {x, y}); });
+    }
+
+    Engine engine() const noexcept override {
+        return Engine::kScan;
+    }
+
+private:
+    poly::VertexBuffer vertices_;
+};
+
+// Polygons smaller than this are scanned, no index beats a handful of edges in cache.
+constexpr size_t kMinIndexedEdgeCount = 32;
+
+// The monotone chain engine is chosen when chains average at least this many edges.
+constexpr size_t kMinEdgesPerChain = 8;
+
+// Convex polygons with fewer edges than this are scanned, the two binary searches cost more than the edges.
+constexpr size_t kMinConvexEdgeCount = 8;
+
+// The rectilinear engine is only chosen when its slabs hold at most this many edges per polygon edge on average, its
+// memory grows quadratically for polygons like staircases.
+constexpr size_t kMaxSlabEntriesPerEdge = 32;
+
+// Batches evaluate every edge for every point on the point batch engine, so it is only chosen for polygons this small,
+// where a lane group of points costs less than one point's walk through an index.
+constexpr size_t kMaxPointBatchEdgeCount = 64;
+
+// The point batch engine is chosen when the expected batch holds at least this many points per edge, so that the
+// padded last lane group and the edge loop overhead are spread over enough points.
+constexpr size_t kMinBatchPointsPerEdge = 4;
+
+// The kernel search of the star engine costs O(n * k) for a kernel with k corners, so automatic selection gives up on
+// polygons whose kernel grows larger than this rather than spend quadratic time on every Prepare().
+constexpr size_t kMaxSelectedKernelCorners = 64;
+
+// Picks the engine expected to answer queries fastest for a normalized polygon queried batch_size points at a time.
+// Sets the kernel point when the pick is the star engine.
+Engine SelectEngine(const poly::Polygon& polygon, bool simple, size_t batch_size,
+                    std::optional<std::pair<float, float>>& kernel_point) {
+    size_t edge_count = polygon.size() - 1;
+    if (edge_count <= kMaxPointBatchEdgeCount && batch_size >= kMinBatchPointsPerEdge * edge_count) {
+        return Engine::kPointBatch;
+    }
+    if (edge_count >= kMinConvexEdgeCount && RectilinearPolygon::IsRectilinear(polygon) &&
+        RectilinearPolygon::CountSlabEntries(polygon) <= kMaxSlabEntriesPerEdge * edge_count) {
+        return Engine::kRectilinear;
+    }
+    if (simple && edge_count >= kMinConvexEdgeCount && ConvexPolygon::IsConvex(polygon)) {
+        return Engine::kConvex;
+    }
+    if (edge_count < kMinIndexedEdgeCount) {
+        return Engine::kScan;
+    }
+    if (MonotoneChainPolygon::CountChains(polygon) * kMinEdgesPerChain <= edge_count) {
+        return Engine::kMonotoneChain;
+    }
+    if (simple && (kernel_point = StarPolygon::FindKernelPoint(polygon, kMaxSelectedKernelCorners))) {
+        return Engine::kStar;
+    }
+    return Engine::kEdgeIntervalTree;
+}
+
+}  // namespace
+
+void IPreparedPolygon::CalculateWindingNumbers2D(const float* x, const float* y, size_t count,
+                                                 int* winding_numbers) const {
+    for (size_t i = 0; i < count; ++i) {
+        winding_numbers[i] = CalculateWindingNumber2D(x[i], y[i]);
+    }
+}
+
+std::optional<bool> IPreparedPolygon::simple() const noexcept {
+    return simple_;
+}
+
+float NormalizedPolygon::vertex_reduction() const noexcept {
+    if (input_vertex_count == 0) {
+        return 0.f;
+    }
+    return float(duplicate_vertices_removed + collinear_vertices_removed) / float(input_vertex_count);
+}
+
+std::optional<NormalizedPolygon> IWindingNumberAlgorithm::Normalize(const poly::Polygon& polygon) {
+    size_t poly_size = polygon.size();
+    if (poly_size == 0 || !polygon.IsClosed(tolerance())) {
+        error_message("Input polygon is not closed.");
+        return std::nullopt;
+    }
+
+    // Collapse tolerance duplicates the same way SimpleWindingNumberAlgorithm skips them: against the last vertex
+    // kept rather than the previous input vertex. The closing vertex is treated as the first one.
+    Point first = ExtractPoint(polygon, 0);
+    std::vector<Point> ring = {first};
+    ring.reserve(poly_size);
+    for (size_t i = 1; i + 1 < poly_size; ++i) {
+        Point b = ExtractPoint(polygon, i);
+        if (WithinTolerance(tolerance(), ring.back(), b)) continue;
+        ring.push_back(b);
+    }
+    while (ring.size() > 1 && WithinTolerance(tolerance(), ring.back(), first)) {
+        ring.pop_back();
+    }
+    if (ring.size() < 2) {
+        error_message("Insufficient geometry in polygon for a meaningful result");
+        return std::nullopt;
+    }
+
+    std::vector<Point> merged = MergeCollinearRuns(ring, tolerance());
+
+    NormalizedPolygon normalized;
+    normalized.polygon = poly::Polygon(merged.size() + 1);
+    for (const Point& vertex : merged) {
+        normalized.polygon.AppendPoint(vertex.x, vertex.y);
+    }
+    normalized.polygon.AppendPoint(merged.front().x, merged.front().y);
+    normalized.input_vertex_count = poly_size;
+    normalized.duplicate_vertices_removed = poly_size - (ring.size() + 1);
+    normalized.collinear_vertices_removed = ring.size() - merged.size();
+    return normalized;
+}
+
+std::unique_ptr<IPreparedPolygon> IWindingNumberAlgorithm::Prepare(const poly::Polygon& polygon, Engine engine,
+                                                                   size_t batch_size) {
+    auto normalized = Normalize(polygon);
+    if (!normalized) {
+        return nullptr;
+    }
+    // The O(n log n) sweep only runs for the engine selector and the engines whose use depends on simplicity, the
+    // others answer the same either way.
+    std::optional<bool> simple;
+    if (engine == Engine::kAutomatic || engine == Engine::kConvex || engine == Engine::kStar) {
+        simple = IsSimple(normalized->polygon);
+    }
+    std::optional<std::pair<float, float>> kernel_point;
+    if (engine == Engine::kAutomatic) {
+        engine = SelectEngine(normalized->polygon, *simple, batch_size, kernel_point);
+    }
+    std::unique_ptr<IPreparedPolygon> prepared;
+    switch (engine) {
+    case Engine::kAutomatic:
+    case Engine::kScan:
+        prepared = std::make_unique<ScanPreparedPolygon>(std::move(normalized->polygon), vertex_layout());
+        break;
+    case Engine::kMonotoneChain:
+        prepared = std::make_unique<MonotoneChainPolygon>(normalized->polygon);
+        break;
+    case Engine::kEdgeIntervalTree:
+        prepared = std::make_unique<EdgeIntervalTreePolygon>(normalized->polygon);
+        break;
+    case Engine::kQuadtree:
+        prepared = std::make_unique<QuadtreePolygon>(normalized->polygon);
+        break;
+    case Engine::kConvex:
+        if (!ConvexPolygon::IsConvex(normalized->polygon)) {
+            error_message("Input polygon is not convex.");
+            return nullptr;
+        }
+        prepared = std::make_unique<ConvexPolygon>(normalized->polygon);
+        break;
+    case Engine::kRectilinear:
+        if (!RectilinearPolygon::IsRectilinear(normalized->polygon)) {
+            error_message("Input polygon is not rectilinear.");
+            return nullptr;
+        }
+        prepared = std::make_unique<RectilinearPolygon>(normalized->polygon);
+        break;
+    case Engine::kStar:
+        if (!kernel_point && !(kernel_point = StarPolygon::FindKernelPoint(normalized->polygon))) {
+            error_message("Input polygon is not star-shaped.");
+            return nullptr;
+        }
+        prepared = std::make_unique<StarPolygon>(normalized->polygon, *kernel_point);
+        break;
+    case Engine::kHullFilter: {
+        auto fallback = std::make_unique<ScanPreparedPolygon>(normalized->polygon, vertex_layout());
+        prepared = std::make_unique<HullFilteredPolygon>(normalized->polygon, std::move(fallback));
+        break;
+    }
+    case Engine::kPointBatch:
+        prepared = std::make_unique<PointBatchPolygon>(std::move(normalized->polygon), vertex_layout());
+        break;
+    }
+    if (prepared) {
+        prepared->simple_ = simple;
+        return prepared;
+    }
+    error_message("Unknown winding number engine requested.");
+    return nullptr;
+}
+
+}  // namespace winding_number
@@ -0,0 +1,216 @@
+#include <quadtree.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <edge_interval_tree.hpp>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeContribution;
+using internal::EdgeXExtent;
+using internal::FuzzyEquals;
+using internal::Point;
+
+// Relative size of the margin cells are widened by, comfortably larger than the rounding error of CrossProduct().
+constexpr float kRelativeMargin = 1e-5f;
+
+}  // namespace
+
+QuadtreePolygon::QuadtreePolygon(const poly::Polygon& polygon, size_t max_leaf_edges, size_t max_depth) :
+        max_leaf_edges_(std::max<size_t>(max_leaf_edges, 1)),
+        max_depth_(max_depth) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    size_t edge_count = polygon.size() - 1;
+
+    Node root = {x_vec[0], y_vec[0], x_vec[0], y_vec[0], -1, 0, 0, 0};
+    edges_.reserve(edge_count);
+    for (size_t i = 0; i < edge_count; ++i) {
+        Edge edge = {x_vec[i], y_vec[i], x_vec[i + 1], y_vec[i + 1]};
+        float lo, hi;
+        EdgeXExtent({edge.ax, edge.ay}, {edge.bx, edge.by}, lo, hi);
+        if (std::isfinite(lo) && std::isfinite(hi)) {
+            root.min_x = std::min(root.min_x, lo);
+            root.max_x = std::max(root.max_x, hi);
+        }
+        root.min_y = std::min({root.min_y, edge.ay, edge.by});
+        root.max_y = std::max({root.max_y, edge.ay, edge.by});
+        edges_.push_back(edge);
+    }
+
+    float scale = std::max({std::abs(root.min_x), std::abs(root.max_x), std::abs(root.min_y), std::abs(root.max_y),
+                            root.max_x - root.min_x, root.max_y - root.min_y, 1.f});
+    margin_ = kRelativeMargin * scale;
+    root.min_x -= 2 * margin_;
+    root.min_y -= 2 * margin_;
+    root.max_x += 2 * margin_;
+    root.max_y += 2 * margin_;
+    nodes_.push_back(root);
+
+    // Edge-free leaves are classified once with an exact engine at their center, which is well clear of every edge.
+    EdgeIntervalTreePolygon classifier(polygon);
+    std::vector<uint32_t> edges(edge_count);
+    for (size_t i = 0; i < edge_count; ++i) {
+        edges[i] = uint32_t(i);
+    }
+    Build(0, edges, 0, classifier);
+}
+
+void QuadtreePolygon::Build(size_t node, std::vector<uint32_t>& edges, size_t depth,
+                            const IPreparedPolygon& classifier) {
+    depth_ = std::max(depth_, depth);
+    if (edges.empty()) {
+        const Node& leaf = nodes_[node];
+        int winding_number = classifier.CalculateWindingNumber2D(0.5f * (leaf.min_x + leaf.max_x),
+                                                                 0.5f * (leaf.min_y + leaf.max_y));
+        nodes_[node].winding_number = winding_number;
+        ++(winding_number != 0 ? inside_leaf_count_ : outside_leaf_count_);
+        return;
+    }
+
+    if (edges.size() <= max_leaf_edges_ || depth >= max_depth_) {
+        nodes_[node].first_edge = uint32_t(edge_indices_.size());
+        nodes_[node].edge_count = uint32_t(edges.size());
+        edge_indices_.insert(edge_indices_.end(), edges.begin(), edges.end());
+        ++boundary_leaf_count_;
+        return;
+    }
+
+    // Children are ordered bottom-left, bottom-right, top-left, top-right, matching Locate().
+    Node parent = nodes_[node];
+    float mid_x = 0.5f * (parent.min_x + parent.max_x);
+    float mid_y = 0.5f * (parent.min_y + parent.max_y);
+    int32_t first_child = int32_t(nodes_.size());
+    nodes_[node].first_child = first_child;
+    nodes_.push_back({parent.min_x, parent.min_y, mid_x, mid_y, -1, 0, 0, 0});
+    nodes_.push_back({mid_x, parent.min_y, parent.max_x, mid_y, -1, 0, 0, 0});
+    nodes_.push_back({parent.min_x, mid_y, mid_x, parent.max_y, -1, 0, 0, 0});
+    nodes_.push_back({mid_x, mid_y, parent.max_x, parent.max_y, -1, 0, 0, 0});
+
+    std::vector<uint32_t> child_edges;
+    child_edges.reserve(edges.size());
+    for (int32_t child = first_child; child < first_child + 4; ++child) {
+        child_edges.clear();
+        for (uint32_t edge : edges) {
+            if (Touches(edges_[edge], nodes_[child])) {
+                child_edges.push_back(edge);
+            }
+        }
+        Build(child, child_edges, depth + 1, classifier);
+    }
+}
+
+bool QuadtreePolygon::Touches(const Edge& edge, const Node& node) const {
+    float min_x = node.min_x - margin_, max_x = node.max_x + margin_;
+    float min_y = node.min_y - margin_, max_y = node.max_y + margin_;
+
+    float lo, hi;
+    EdgeXExtent({edge.ax, edge.ay}, {edge.bx, edge.by}, lo, hi);
+    if (hi < min_x || lo > max_x || std::max(edge.ay, edge.by) < min_y || std::min(edge.ay, edge.by) > max_y) {
+        return false;
+    }
+    // Near vertical edges count for every point within their widened extent, not just the ones on the segment.
+    if (FuzzyEquals(edge.ax, edge.bx)) {
+        return true;
+    }
+
+    // The bounding boxes overlap, so the segment misses the cell only if all four corners are on one side of it.
+    double normal_x = double(edge.ay) - edge.by;
+    double normal_y = double(edge.bx) - edge.ax;
+    double offset = normal_x * edge.ax + normal_y * edge.ay;
+    int above = 0, below = 0;
+    for (float corner_x : {min_x, max_x}) {
+        for (float corner_y : {min_y, max_y}) {
+            double side = normal_x * corner_x + normal_y * corner_y - offset;
+            above += side > 0;
+            below += side < 0;
+        }
+    }
+    return above != 4 && below != 4;
+}
+
+const QuadtreePolygon::Node& QuadtreePolygon::Locate(float x, float y) const {
+    const Node* node = &nodes_[0];
+    while (node->first_child >= 0) {
+        const Node* children = &nodes_[node->first_child];
+        node = &children[(x >= children[1].min_x ? 1 : 0) + (y >= children[2].min_y ? 2 : 0)];
+    }
+    return *node;
+}
+
+int QuadtreePolygon::CalculateWindingNumber2D(float x, float y) const {
+    const Node& root = nodes_[0];
+    if (x < root.min_x || x >= root.max_x || y >= root.max_y) {
+        return 0;
+    }
+
+    // Walk up the column of leaves above the point, collecting the edges passed, until an edge-free leaf is found.
+    // Edges outside of the walked leaves cannot tell the point apart from the bottom of that leaf, so only the
+    // collected ones need evaluating.
+    thread_local std::vector<uint32_t> passed_edges;
+    passed_edges.clear();
+    Point p = {x, y};
+    int winding_number = 0;
+    bool has_reference = false;
+    Point reference = p;
+    for (float walk_y = std::max(y, root.min_y); walk_y < root.max_y;) {
+        const Node& leaf = Locate(x, walk_y);
+        if (leaf.edge_count == 0) {
+            winding_number = leaf.winding_number;
+            reference = {x, leaf.min_y};
+            has_reference = true;
+            break;
+        }
+        passed_edges.insert(passed_edges.end(), edge_indices_.begin() + leaf.first_edge,
+                            edge_indices_.begin() + leaf.first_edge + leaf.edge_count);
+        walk_y = leaf.max_y;
+    }
+    if (passed_edges.empty()) {
+        return winding_number;
+    }
+
+    // Leaves overlap by the margin, so an edge may have been passed more than once.
+    std::sort(passed_edges.begin(), passed_edges.end());
+    passed_edges.erase(std::unique(passed_edges.begin(), passed_edges.end()), passed_edges.end());
+    for (uint32_t index : passed_edges) {
+        const Edge& edge = edges_[index];
+        Point a = {edge.ax, edge.ay};
+        Point b = {edge.bx, edge.by};
+        winding_number += EdgeContribution(a, b, p);
+        if (has_reference) {
+            winding_number -= EdgeContribution(a, b, reference);
+        }
+    }
+    return winding_number;
+}
+
+Engine QuadtreePolygon::engine() const noexcept {
+    return Engine::kQuadtree;
+}
+
+size_t QuadtreePolygon::depth() const noexcept {
+    return depth_;
+}
+
+size_t QuadtreePolygon::node_count() const noexcept {
+    return nodes_.size();
+}
+
+size_t QuadtreePolygon::inside_leaf_count() const noexcept {
+    return inside_leaf_count_;
+}
+
+size_t QuadtreePolygon::outside_leaf_count() const noexcept {
+    return outside_leaf_count_;
+}
+
+size_t QuadtreePolygon::boundary_leaf_count() const noexcept {
+    return boundary_leaf_count_;
+}
+
+}  // namespace winding_number
@@ -0,0 +1,145 @@
+#include <rectilinear.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::EdgeContribution;
+using internal::EdgeXExtent;
+
+// The distinct x coordinates of the polygon's vertices, in increasing order.
+std::vector<float> SlabBoundaries(const poly::Polygon& polygon) {
+    std::vector<float> slab_x(polygon.x_vec_);
+    std::sort(slab_x.begin(), slab_x.end());
+    slab_x.erase(std::unique(slab_x.begin(), slab_x.end()), slab_x.end());
+    return slab_x;
+}
+
+size_t SlabIndex(const std::vector<float>& slab_x, float x) {
+    return std::lower_bound(slab_x.begin(), slab_x.end(), x) - slab_x.begin();
+}
+
+}  // namespace
+
+RectilinearPolygon::RectilinearPolygon(const poly::Polygon& polygon) : slab_x_(SlabBoundaries(polygon)) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    size_t slab_count = slab_x_.empty() ? 0 : slab_x_.size() - 1;
+
+    // Each slab's edges as (height, +1 for leftward or -1 for rightward).
+    std::vector<std::vector<std::pair<float, int>>> slabs(slab_count);
+    std::vector<VerticalEdge> vertical_edges;
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        float ax = x_vec[i], ay = y_vec[i], bx = x_vec[i + 1], by = y_vec[i + 1];
+        if (ax == bx) {
+            // Downward edges never contribute, they are neither crossed nor counted when a point is on them.
+            if (ay < by) {
+                VerticalEdge edge = {ax, 0.f, 0.f, ay, by};
+                EdgeXExtent({ax, ay}, {bx, by}, edge.lo, edge.hi);
+                vertical_edges.push_back(edge);
+            }
+            continue;
+        }
+        size_t first = SlabIndex(slab_x_, std::min(ax, bx)), last = SlabIndex(slab_x_, std::max(ax, bx));
+        for (size_t slab = first; slab < last; ++slab) {
+            slabs[slab].emplace_back(ay, bx < ax ? 1 : -1);
+        }
+    }
+
+    slab_first_.push_back(0);
+    for (size_t slab = 0; slab < slab_count; ++slab) {
+        auto& entries = slabs[slab];
+        std::sort(entries.begin(), entries.end());
+        size_t sums_first = leftward_suffix_.size();
+        leftward_suffix_.resize(sums_first + entries.size() + 1, 0);
+        rightward_suffix_.resize(sums_first + entries.size() + 1, 0);
+        for (size_t i = entries.size(); i-- > 0;) {
+            leftward_suffix_[sums_first + i] = leftward_suffix_[sums_first + i + 1] + (entries[i].second > 0);
+            rightward_suffix_[sums_first + i] = rightward_suffix_[sums_first + i + 1] + (entries[i].second < 0);
+        }
+        for (const auto& entry : entries) {
+            entry_y_.push_back(entry.first);
+        }
+        slab_first_.push_back(uint32_t(entry_y_.size()));
+    }
+
+    std::vector<size_t> order(vertical_edges.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&vertical_edges](size_t i, size_t j) { return vertical_edges[i].lo < vertical_edges[j].lo; });
+    for (size_t i : order) {
+        const VerticalEdge& edge = vertical_edges[i];
+        vertical_edges_.push_back(edge);
+        vertical_lo_.push_back(edge.lo);
+        vertical_reach_.push_back(vertical_reach_.empty() ? edge.hi : std::max(vertical_reach_.back(), edge.hi));
+    }
+}
+
+int RectilinearPolygon::VerticalContribution(float x, float y) const {
+    int winding_number = 0;
+    size_t candidates = std::upper_bound(vertical_lo_.begin(), vertical_lo_.end(), x) - vertical_lo_.begin();
+    for (size_t i = candidates; i-- > 0 && vertical_reach_[i] >= x;) {
+        const VerticalEdge& edge = vertical_edges_[i];
+        if (edge.hi >= x && edge.ay <= y && y <= edge.by) {
+            winding_number += EdgeContribution({edge.x, edge.ay}, {edge.x, edge.by}, {x, y});
+        }
+    }
+    return winding_number;
+}
+
+int RectilinearPolygon::CalculateWindingNumber2D(float x, float y) const {
+    int winding_number = VerticalContribution(x, y);
+
+    // Horizontal edges with a.x <= p.x < b.x (in either direction) are exactly those spanning the point's slab.
+    size_t upper = std::upper_bound(slab_x_.begin(), slab_x_.end(), x) - slab_x_.begin();
+    if (upper == 0 || upper == slab_x_.size()) {
+        return winding_number;
+    }
+    size_t slab = upper - 1;
+    auto first = entry_y_.begin() + slab_first_[slab];
+    auto last = entry_y_.begin() + slab_first_[slab + 1];
+    // For a horizontal edge the cross product is (b.x - a.x) * (p.y - y), so a leftward edge counts when the point is
+    // at or below it and a rightward one when the point is strictly below it. (The scan's float product can round to
+    // zero for coordinates below about 1e-19, which this does not reproduce.)
+    size_t at_or_above = std::lower_bound(first, last, y) - entry_y_.begin();
+    size_t above = std::upper_bound(first, last, y) - entry_y_.begin();
+    return winding_number + leftward_suffix_[at_or_above + slab] - rightward_suffix_[above + slab];
+}
+
+Engine RectilinearPolygon::engine() const noexcept {
+    return Engine::kRectilinear;
+}
+
+size_t RectilinearPolygon::slab_count() const noexcept {
+    return slab_first_.size() - 1;
+}
+
+bool RectilinearPolygon::IsRectilinear(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        if (x_vec[i] != x_vec[i + 1] && y_vec[i] != y_vec[i + 1]) {
+            return false;
+        }
+    }
+    return polygon.size() > 1;
+}
+
+size_t RectilinearPolygon::CountSlabEntries(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    std::vector<float> slab_x = SlabBoundaries(polygon);
+    size_t entries = 0;
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        if (x_vec[i] != x_vec[i + 1]) {
+            size_t first = SlabIndex(slab_x, std::min(x_vec[i], x_vec[i + 1]));
+            entries += SlabIndex(slab_x, std::max(x_vec[i], x_vec[i + 1])) - first;
+        }
+    }
+    return entries;
+}
+
+}  // namespace winding_number
@@ -0,0 +1,160 @@
+#include <self_intersection.hpp>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace winding_number {
+namespace {
+
+// An edge with its endpoints ordered along the sweep, so that a comes first.
+struct SweepEdge {
+    double ax, ay, bx, by;
+    size_t index;
+};
+
+struct SweepEvent {
+    double x, y;
+    bool insert;
+    size_t edge;
+};
+
+double Orientation(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+// Whether c, known to be on the line through a and b, lies on the segment [a, b].
+bool WithinBox(double ax, double ay, double bx, double by, double cx, double cy) {
+    return std::min(ax, bx) <= cx && cx <= std::max(ax, bx) && std::min(ay, by) <= cy && cy <= std::max(ay, by);
+}
+
+bool SegmentsIntersect(const SweepEdge& e, const SweepEdge& f) {
+    double d1 = Orientation(e.ax, e.ay, e.bx, e.by, f.ax, f.ay);
+    double d2 = Orientation(e.ax, e.ay, e.bx, e.by, f.bx, f.by);
+    double d3 = Orientation(f.ax, f.ay, f.bx, f.by, e.ax, e.ay);
+    double d4 = Orientation(f.ax, f.ay, f.bx, f.by, e.bx, e.by);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+        return true;
+    }
+    return (d1 == 0 && WithinBox(e.ax, e.ay, e.bx, e.by, f.ax, f.ay)) ||
+           (d2 == 0 && WithinBox(e.ax, e.ay, e.bx, e.by, f.bx, f.by)) ||
+           (d3 == 0 && WithinBox(f.ax, f.ay, f.bx, f.by, e.ax, e.ay)) ||
+           (d4 == 0 && WithinBox(f.ax, f.ay, f.bx, f.by, e.bx, e.by));
+}
+
+// The sweep status: the edges crossing the sweep line, ordered from the bottom up at the current event point. Tying
+// the ordering to the event point, rather than only its x coordinate, treats the sweep line as turned ever so slightly
+// clockwise, which places vertical edges without special cases.
+class SweepOrder {
+public:
+    explicit SweepOrder(const double* sweep) : sweep_(sweep) {}
+
+    bool operator()(const SweepEdge* lhs, const SweepEdge* rhs) const {
+        double lhs_y = HeightAtSweep(*lhs), rhs_y = HeightAtSweep(*rhs);
+        if (lhs_y != rhs_y) {
+            return lhs_y < rhs_y;
+        }
+        // Edges meeting at the sweep point are ordered by where they go next.
+        double turn = (lhs->bx - lhs->ax) * (rhs->by - rhs->ay) - (lhs->by - lhs->ay) * (rhs->bx - rhs->ax);
+        if (turn != 0) {
+            return turn > 0;
+        }
+        return lhs->index < rhs->index;
+    }
+
+private:
+    double HeightAtSweep(const SweepEdge& edge) const {
+        double x = sweep_[0], y = sweep_[1];
+        if (x <= edge.ax) {
+            return edge.ax == edge.bx ? std::max(edge.ay, std::min(y, edge.by)) : edge.ay;
+        }
+        if (x >= edge.bx) {
+            return edge.by;
+        }
+        return edge.ay + (x - edge.ax) * (edge.by - edge.ay) / (edge.bx - edge.ax);
+    }
+
+    const double* sweep_;
+};
+
+}  // namespace
+
+std::optional<std::pair<size_t, size_t>> FindSelfIntersection(const poly::Polygon& polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    size_t edge_count = polygon.size() < 2 ? 0 : polygon.size() - 1;
+
+    std::vector<SweepEdge> edges;
+    std::vector<SweepEvent> events;
+    edges.reserve(edge_count);
+    events.reserve(2 * edge_count);
+    for (size_t i = 0; i < edge_count; ++i) {
+        double ax = x_vec[i], ay = y_vec[i], bx = x_vec[i + 1], by = y_vec[i + 1];
+        if (bx < ax || (bx == ax && by < ay)) {
+            std::swap(ax, bx);
+            std::swap(ay, by);
+        }
+        edges.push_back({ax, ay, bx, by, i});
+        events.push_back({ax, ay, true, i});
+        events.push_back({bx, by, false, i});
+    }
+    // At a shared point, edges are inserted before any are removed so that edges which only touch there still meet in
+    // the sweep status.
+    std::sort(events.begin(), events.end(), [](const SweepEvent& lhs, const SweepEvent& rhs) {
+        if (lhs.x != rhs.x) return lhs.x < rhs.x;
+        if (lhs.y != rhs.y) return lhs.y < rhs.y;
+        return lhs.insert && !rhs.insert;
+    });
+
+    auto adjacent = [edge_count](size_t i, size_t j) {
+        size_t lo = std::min(i, j), hi = std::max(i, j);
+        return hi == lo + 1 || (lo == 0 && hi == edge_count - 1);
+    };
+    // Adjacent edges always share a vertex, they only intersect when they double back over each other.
+    auto intersect = [&](const SweepEdge* e, const SweepEdge* f) {
+        if (edge_count > 2 && adjacent(e->index, f->index)) {
+            size_t first = std::min(e->index, f->index), second = std::max(e->index, f->index);
+            if (first == 0 && second == edge_count - 1) {
+                std::swap(first, second);
+            }
+            double px = x_vec[first], py = y_vec[first];
+            double vx = x_vec[second], vy = y_vec[second];
+            double qx = x_vec[second + 1], qy = y_vec[second + 1];
+            return Orientation(px, py, vx, vy, qx, qy) == 0 && (px - vx) * (qx - vx) + (py - vy) * (qy - vy) > 0;
+        }
+        return SegmentsIntersect(*e, *f);
+    };
+
+    double sweep[2] = {0, 0};
+    std::set<const SweepEdge*, SweepOrder> status{SweepOrder(sweep)};
+    std::vector<std::set<const SweepEdge*, SweepOrder>::iterator> positions(edge_count, status.end());
+    for (const auto& event : events) {
+        sweep[0] = event.x;
+        sweep[1] = event.y;
+        const SweepEdge* edge = &edges[event.edge];
+        if (event.insert) {
+            auto position = status.insert(edge).first;
+            positions[event.edge] = position;
+            if (position != status.begin() && intersect(*std::prev(position), edge)) {
+                return std::make_pair((*std::prev(position))->index, edge->index);
+            }
+            if (std::next(position) != status.end() && intersect(*std::next(position), edge)) {
+                return std::make_pair((*std::next(position))->index, edge->index);
+            }
+        } else {
+            auto position = positions[event.edge];
+            if (position != status.begin() && std::next(position) != status.end() &&
+                intersect(*std::prev(position), *std::next(position))) {
+                return std::make_pair((*std::prev(position))->index, (*std::next(position))->index);
+            }
+            status.erase(position);
+        }
+    }
+    return std::nullopt;
+}
+
+bool IsSimple(const poly::Polygon& polygon) {
+    return !FindSelfIntersection(polygon).has_value();
+}
+
+}  // namespace winding_number
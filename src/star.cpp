@@ -0,0 +1,242 @@
+#include <star.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "winding_internal.hpp"
+
+namespace winding_number {
+namespace {
+
+using internal::BuildSubtreeHighX;
+using internal::EdgeXExtent;
+using internal::FuzzyEquals;
+using internal::SubtreeRoot;
+
+constexpr double kPi = 3.14159265358979323846;
+
+// Points closer than this (relative to the polygon's coordinates) to an edge may be classified differently by the
+// float cross products of a scan than by exact geometry.
+constexpr double kRelativeMargin = 1e-5;
+
+double Cross(double ax, double ay, double bx, double by) {
+    return ax * by - ay * bx;
+}
+
+// Twice the signed area, positive for counter-clockwise polygons.
+double TwiceArea(const poly::Polygon& polygon) {
+    double twice_area = 0;
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        twice_area += Cross(polygon.x_vec_[i], polygon.y_vec_[i], polygon.x_vec_[i + 1], polygon.y_vec_[i + 1]);
+    }
+    return twice_area;
+}
+
+}  // namespace
+
+StarPolygon::StarPolygon(const poly::Polygon& polygon, std::pair<float, float> kernel_point) :
+        center_x_(kernel_point.first), center_y_(kernel_point.second), fallback_(polygon) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    size_t vertex_count = polygon.size() - 1;
+    bool clockwise = TwiceArea(polygon) < 0;
+    inside_winding_number_ = clockwise ? -1 : 1;
+
+    // Walk the polygon counter-clockwise, starting from the vertex with the smallest angle.
+    std::vector<size_t> order(vertex_count);
+    for (size_t i = 0; i < vertex_count; ++i) {
+        order[i] = clockwise ? vertex_count - 1 - i : i;
+    }
+    auto angle = [&](size_t vertex) { return std::atan2(y_vec[vertex] - center_y_, x_vec[vertex] - center_x_); };
+    std::rotate(order.begin(), std::min_element(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+                    return angle(lhs) < angle(rhs);
+                }), order.end());
+    for (size_t vertex : order) {
+        angles_.push_back(angle(vertex));
+        x_vec_.push_back(x_vec[vertex] - center_x_);
+        y_vec_.push_back(y_vec[vertex] - center_y_);
+    }
+    x_vec_.push_back(x_vec_.front());
+    y_vec_.push_back(y_vec_.front());
+
+    double scale = 1;
+    for (size_t i = 0; i < vertex_count; ++i) {
+        scale = std::max({scale, double(std::abs(x_vec[i])), double(std::abs(y_vec[i]))});
+        if (FuzzyEquals(x_vec[i], x_vec[i + 1]) && y_vec[i] < y_vec[i + 1]) {
+            Box box = {0.f, y_vec[i], 0.f, y_vec[i + 1]};
+            EdgeXExtent({x_vec[i], y_vec[i]}, {x_vec[i + 1], y_vec[i + 1]}, box.min_x, box.max_x);
+            vertical_boxes_.push_back(box);
+        }
+    }
+    margin_ = kRelativeMargin * scale;
+
+    std::sort(vertical_boxes_.begin(), vertical_boxes_.end(),
+              [](const Box& lhs, const Box& rhs) { return lhs.min_x < rhs.min_x; });
+    std::vector<float> max_x;
+    for (const auto& box : vertical_boxes_) {
+        max_x.push_back(box.max_x);
+    }
+    vertical_boxes_subtree_max_x_.resize(vertical_boxes_.size());
+    BuildSubtreeHighX(max_x, vertical_boxes_subtree_max_x_, 0, vertical_boxes_.size());
+}
+
+bool StarPolygon::InVerticalBox(float x, float y) const {
+    // Depth first over the implicit tree, the depth is bounded by log2 of the box count.
+    std::pair<size_t, size_t> pending[64];
+    size_t pending_count = 0;
+    pending[pending_count++] = {0, vertical_boxes_.size()};
+    while (pending_count > 0) {
+        auto [first, last] = pending[--pending_count];
+        if (first >= last) continue;
+        size_t root = SubtreeRoot(first, last);
+        if (vertical_boxes_subtree_max_x_[root] < x) continue;
+
+        pending[pending_count++] = {first, root};
+        const Box& box = vertical_boxes_[root];
+        if (box.min_x <= x) {
+            if (x <= box.max_x && box.min_y <= y && y <= box.max_y) {
+                return true;
+            }
+            pending[pending_count++] = {root + 1, last};
+        }
+    }
+    return false;
+}
+
+double StarPolygon::EdgeDistance(size_t edge, double dx, double dy) const {
+    double ax = x_vec_[edge], ay = y_vec_[edge];
+    double ex = x_vec_[edge + 1] - ax, ey = y_vec_[edge + 1] - ay;
+    double length_squared = ex * ex + ey * ey;
+    double t = length_squared > 0 ? std::clamp(((dx - ax) * ex + (dy - ay) * ey) / length_squared, 0.0, 1.0) : 0.0;
+    return std::hypot(dx - ax - t * ex, dy - ay - t * ey);
+}
+
+bool StarPolygon::NearBoundary(double dx, double dy, size_t wedge) const {
+    double radius = std::hypot(dx, dy);
+    if (radius <= margin_) {
+        return true;
+    }
+    // Any edge within the margin of the point has part of its wedge within this angle of the point's direction.
+    double theta = std::atan2(dy, dx);
+    double spread = std::asin(std::min(1.0, margin_ / radius)) + 1e-9;
+    size_t wedge_count = angles_.size();
+    if (EdgeDistance(wedge, dx, dy) <= margin_) {
+        return true;
+    }
+    size_t checked = 1;
+    for (size_t before = wedge; checked < wedge_count; ++checked) {
+        if (std::remainder(theta - angles_[before], 2 * kPi) >= spread) break;
+        before = (before + wedge_count - 1) % wedge_count;
+        if (EdgeDistance(before, dx, dy) <= margin_) return true;
+    }
+    for (size_t after = wedge; checked < wedge_count; ++checked) {
+        if (std::remainder(angles_[(after + 1) % wedge_count] - theta, 2 * kPi) >= spread) break;
+        after = (after + 1) % wedge_count;
+        if (EdgeDistance(after, dx, dy) <= margin_) return true;
+    }
+    return false;
+}
+
+int StarPolygon::CalculateWindingNumber2D(float x, float y) const {
+    if (InVerticalBox(x, y)) {
+        return fallback_.CalculateWindingNumber2D(x, y);
+    }
+
+    double dx = x - center_x_, dy = y - center_y_;
+    size_t upper = std::upper_bound(angles_.begin(), angles_.end(), std::atan2(dy, dx)) - angles_.begin();
+    size_t wedge = upper == 0 ? angles_.size() - 1 : upper - 1;
+    if (NearBoundary(dx, dy, wedge)) {
+        return fallback_.CalculateWindingNumber2D(x, y);
+    }
+    // The kernel point sees the whole wedge, so the point is inside exactly when it is on the kernel point's side of
+    // the edge closing the wedge.
+    double ax = x_vec_[wedge], ay = y_vec_[wedge];
+    double side = Cross(x_vec_[wedge + 1] - ax, y_vec_[wedge + 1] - ay, dx - ax, dy - ay);
+    return side > 0 ? inside_winding_number_ : 0;
+}
+
+Engine StarPolygon::engine() const noexcept {
+    return Engine::kStar;
+}
+
+std::pair<float, float> StarPolygon::kernel_point() const noexcept {
+    return {float(center_x_), float(center_y_)};
+}
+
+std::optional<std::pair<float, float>> StarPolygon::FindKernelPoint(const poly::Polygon& polygon,
+                                                                   size_t max_kernel_corners) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    if (polygon.size() < 4) {
+        return std::nullopt;
+    }
+    double orientation = TwiceArea(polygon) < 0 ? -1 : 1;
+
+    // Start from a box around the polygon, the kernel is a subset of the polygon.
+    auto [min_x, max_x] = std::minmax_element(x_vec.begin(), x_vec.end());
+    auto [min_y, max_y] = std::minmax_element(y_vec.begin(), y_vec.end());
+    std::vector<std::pair<double, double>> kernel = {
+            {*min_x - 1.0, *min_y - 1.0}, {*max_x + 1.0, *min_y - 1.0}, {*max_x + 1.0, *max_y + 1.0},
+            {*min_x - 1.0, *max_y + 1.0}};
+    std::vector<std::pair<double, double>> clipped;
+    for (size_t i = 0; i + 1 < polygon.size() && kernel.size() >= 3; ++i) {
+        double ax = x_vec[i], ay = y_vec[i];
+        double ex = x_vec[i + 1] - ax, ey = y_vec[i + 1] - ay;
+        auto side = [&](const std::pair<double, double>& q) {
+            return orientation * Cross(ex, ey, q.first - ax, q.second - ay);
+        };
+        clipped.clear();
+        for (size_t j = 0; j < kernel.size(); ++j) {
+            const auto& current = kernel[j];
+            const auto& next = kernel[(j + 1) % kernel.size()];
+            double current_side = side(current), next_side = side(next);
+            if (current_side >= 0) {
+                clipped.push_back(current);
+            }
+            if ((current_side < 0) != (next_side < 0)) {
+                double t = current_side / (current_side - next_side);
+                clipped.emplace_back(current.first + t * (next.first - current.first),
+                                     current.second + t * (next.second - current.second));
+            }
+        }
+        std::swap(kernel, clipped);
+        if (kernel.size() > max_kernel_corners) {
+            return std::nullopt;
+        }
+    }
+    if (kernel.size() < 3) {
+        return std::nullopt;
+    }
+
+    // The average of the corners of a convex region with any area is strictly inside it.
+    double sum_x = 0, sum_y = 0;
+    for (const auto& [x, y] : kernel) {
+        sum_x += x;
+        sum_y += y;
+    }
+    std::pair<float, float> point = {float(sum_x / kernel.size()), float(sum_y / kernel.size())};
+    if (!IsKernelPoint(polygon, point)) {
+        return std::nullopt;
+    }
+    return point;
+}
+
+bool StarPolygon::IsKernelPoint(const poly::Polygon& polygon, std::pair<float, float> point) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    double orientation = TwiceArea(polygon) < 0 ? -1 : 1;
+    double turning = 0;
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        double ax = x_vec[i] - double(point.first), ay = y_vec[i] - double(point.second);
+        double bx = x_vec[i + 1] - double(point.first), by = y_vec[i + 1] - double(point.second);
+        double cross = Cross(ax, ay, bx, by);
+        if (orientation * cross <= 0) {
+            return false;
+        }
+        turning += std::atan2(cross, ax * bx + ay * by);
+    }
+    // Every edge turns the same way around the point, so going around more than once means winding like a pentagram.
+    return std::abs(turning - orientation * 2 * kPi) < kPi;
+}
+
+}  // namespace winding_number
@@ -0,0 +1,155 @@
+#ifndef STRUCTURAL_SCAN_INTERNAL_HPP_
+#define STRUCTURAL_SCAN_INTERNAL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// A structural scanner for the text polygon format, in the manner of simdjson's first stage: the bytes that give the
+// text its structure (newlines, '#' and the ' ' and '\t' delimiters) are found 64 at a time and kept as bitmasks, and
+// lines and tokens are then read off the masks with bit tricks instead of being searched for byte by byte. Nothing is
+// allocated, and a block is classified with a handful of vector compares (AVX2 or SSE2 where the target has them, a
+// scalar loop elsewhere).
+
+namespace poly {
+namespace internal {
+
+constexpr size_t kBlockSize = 64;
+
+// The structural bytes of a block, bit i of each mask standing for byte i.
+struct BlockMasks {
+    uint64_t newline;    // '\n'
+    uint64_t comment;    // '#'
+    uint64_t delimiter;  // ' ' and '\t'
+};
+
+// Classifies the first size bytes of block, at most kBlockSize of them. The bits past size are clear.
+inline BlockMasks ClassifyBlock(const char* block, size_t size) {
+    char padded[kBlockSize];
+    if (size < kBlockSize) {
+        std::memset(padded, 0, kBlockSize);
+        std::memcpy(padded, block, size);
+        block = padded;
+    }
+    BlockMasks masks = {0, 0, 0};
+#if defined(__AVX2__)
+    for (size_t i = 0; i < kBlockSize; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        auto mask = [&](char c) {
+            return uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c))))) << i;
+        };
+        masks.newline |= mask('\n');
+        masks.comment |= mask('#');
+        masks.delimiter |= mask(' ') | mask('\t');
+    }
+#elif defined(__SSE2__)
+    for (size_t i = 0; i < kBlockSize; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        auto mask = [&](char c) {
+            return uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(c))))) << i;
+        };
+        masks.newline |= mask('\n');
+        masks.comment |= mask('#');
+        masks.delimiter |= mask(' ') | mask('\t');
+    }
+#else
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        masks.newline |= uint64_t(block[i] == '\n') << i;
+        masks.comment |= uint64_t(block[i] == '#') << i;
+        masks.delimiter |= uint64_t(block[i] == ' ' || block[i] == '\t') << i;
+    }
+#endif
+    return masks;
+}
+
+inline size_t CountTrailingZeros(uint64_t mask) {
+#if defined(__GNUC__)
+    return size_t(__builtin_ctzll(mask));
+#else
+    size_t count = 0;
+    for (; !(mask & 1); mask >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// The bytes of a block that are commented out, from each '#' up to the next newline. in_comment tells whether the
+// block starts inside a comment, and is updated to whether the next one does.
+inline uint64_t CommentMask(const BlockMasks& masks, bool& in_comment) {
+    uint64_t comment = 0;
+    uint64_t first = in_comment ? 1 : masks.comment & -masks.comment;
+    while (first) {
+        uint64_t newlines = masks.newline & ~(first - 1);
+        uint64_t last = newlines & -newlines;
+        if (!last) {
+            comment |= ~(first - 1);
+            break;
+        }
+        comment |= last - first;
+        // A '#' in bit 63 of a block would make last << 1 overflow, but then there is no newline after it either.
+        uint64_t hashes = masks.comment & ~((last << 1) - 1);
+        first = hashes & -hashes;
+    }
+    in_comment = comment >> 63;
+    return comment;
+}
+
+// Calls on_token(offset, token) with every token of text, offset counting from the start of the token's line, and
+// on_line(line) at the end of every line, after the tokens in it. Tokens are the runs of bytes between delimiters
+// and newlines, up to the first '#' of the line. Lines are split the way std::getline() splits a stream: a final line
+// without a newline still ends with on_line, but the empty remainder after a trailing newline does not. The scan stops
+// early, returning false, when on_line returns false.
+template <typename OnToken, typename OnLine>
+bool ForEachToken(std::string_view text, OnToken&& on_token, OnLine&& on_line) {
+    size_t line_start = 0;
+    size_t token_start = 0;
+    uint64_t in_token = 0;  // Whether the byte before the block is part of a token.
+    bool in_comment = false;
+    for (size_t block = 0; block < text.size(); block += kBlockSize) {
+        size_t size = std::min(kBlockSize, text.size() - block);
+        BlockMasks masks = ClassifyBlock(text.data() + block, size);
+        uint64_t valid = size == kBlockSize ? ~uint64_t(0) : (uint64_t(1) << size) - 1;
+        uint64_t comment = CommentMask(masks, in_comment);
+        uint64_t token = valid & ~(masks.delimiter | masks.newline | comment);
+        uint64_t after_token = (token << 1) | in_token;
+        uint64_t starts = token & ~after_token;
+        uint64_t ends = valid & ~token & after_token;
+        in_token = (token >> (size - 1)) & 1;
+
+        for (uint64_t events = starts | ends | masks.newline; events; events &= events - 1) {
+            uint64_t bit = events & -events;
+            size_t position = block + CountTrailingZeros(events);
+            if (ends & bit) {
+                on_token(token_start - line_start, text.substr(token_start, position - token_start));
+            }
+            if (starts & bit) {
+                token_start = position;
+            }
+            if (masks.newline & bit) {
+                if (!on_line(text.substr(line_start, position - line_start))) {
+                    return false;
+                }
+                line_start = position + 1;
+            }
+        }
+    }
+    if (in_token) {
+        on_token(token_start - line_start, text.substr(token_start));
+    }
+    if (line_start < text.size()) {
+        return on_line(text.substr(line_start));
+    }
+    return true;
+}
+
+}  // namespace internal
+}  // namespace poly
+
+#endif
@@ -2,9 +2,10 @@
 
 #include <winding.hpp>
 
-#include <cmath>
 #include <utility>
 
+#include "winding_internal.hpp"
+
 // Future Improvements:
 //      - Iterators to improve function of traversing points and edges in a polygon.
 //          - would abstract different ways of filtering points out, and possibly expose as strategies to clients
@@ -24,28 +25,10 @@
 namespace winding_number {
 namespace {
 
-// For convenience, not strictly necessary.
-struct Point { float x, y; };
-
-// Some helper methods that do not need to be bound to a class instance:
-
-// Calculates the z-component of the cross product of the vectors created between: [a, b], [b, c]
-// where the z-component of those vectors is 0. The result is a scalar value that
-// indicates the directional relationship of c w.r.t. the line [a, b].
-// - less than 0: the line is moving clockwise about c.
-// - 0: c is somewhere along the line.
-// - greater than 0: the line is moving counter clockwise about
-float CrossProduct(const Point& a, const Point& b, const Point& c);
-
-// A convenience method that extracts the n'th x and y values from the given
-// polygon and returns them in point-form.
-Point ExtractPoint(const poly::Polygon& polygon, int n);
-
-// Specifies if the given poitns are within tolerance range in both cardinal direction
-bool WithinTolerance(float tolerance, const Point& a, const Point& b);
-
-// Typical fuzzy check, checks for equality out to the n'th decimal.
-bool FuzzyEquals(float a, float b, float max_delta = 1e-6f);
+using internal::EdgeContribution;
+using internal::ExtractPoint;
+using internal::Point;
+using internal::WithinTolerance;
 
 // A straight forward implementation of IWindingNumberAlgorithm. It uses
 // some assumptions about the input polygon and basic two dimensional linear
@@ -70,7 +53,6 @@ class SimpleWindingNumberAlgorithm : public IWindingNumberAlgorithm {
         //   cases to look for.
 
         Point a = ExtractPoint(polygon, 0);
-        bool a_left_or_on_p = a.x <= p.x;   // used to avoid re-doing work.
         size_t poly_size = polygon.size();
         size_t evaluated_edge_count = 0;
         for (int i = 1; i < poly_size; i++) {
@@ -81,27 +63,10 @@ class SimpleWindingNumberAlgorithm : public IWindingNumberAlgorithm {
             // Skip if within tolerance range:
             if (WithinTolerance(tolerance(), a, b)) continue;
 
-            bool b_left_or_on_p = b.x <= p.x;
-
-            // Most edges should arrive here: check for passing p on x axis
-            // and act accordingly.
-            auto cross_product = CrossProduct(a, b, p);
-            if (FuzzyEquals(cross_product, 0) && FuzzyEquals(a.x, b.x) && a.y < b.y
-                && p.y <= b.y && a.y <= p.y) {
-                    // the test point is on a vertically traversing edge
-                winding_number++;
-            }
-            else if (a_left_or_on_p) {
-                // left to right motion, moving clockwise if to right.
-                if (!b_left_or_on_p && cross_product < 0) winding_number--;
-            }
-            else
-                // right to left motion, moving ccw if to left or on the line.
-                if (b_left_or_on_p && cross_product >= 0) winding_number++;
+            winding_number += EdgeContribution(a, b, p);
 
             // update trackers.
             a = b;
-            a_left_or_on_p = b_left_or_on_p;
             evaluated_edge_count++;
         }
 
@@ -114,22 +79,6 @@ class SimpleWindingNumberAlgorithm : public IWindingNumberAlgorithm {
     }
 };
 
-float CrossProduct(const Point& a, const Point& b, const Point& c) {
-    return ((b.x - a.x) * (c.y - b.y)) - ((b.y - a.y) * (c.x - b.x));
-}
-
-Point ExtractPoint(const poly::Polygon& polygon, int n) {
-    return {polygon.x_vec_.at(n), polygon.y_vec_.at(n)};
-}
-
-bool WithinTolerance(float tolerance, const Point& a, const Point& b) {
-    return (std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance);
-}
-
-bool FuzzyEquals(float a, float b, float max_delta) {
-    return (std::abs(a -b) <= max_delta);
-}
-
 }  // namespace
 
 std::unique_ptr<IWindingNumberAlgorithm> IWindingNumberAlgorithm::Create() {
@@ -144,6 +93,14 @@ float IWindingNumberAlgorithm::tolerance() const noexcept {
     return tolerance_;
 }
 
+poly::VertexLayout IWindingNumberAlgorithm::vertex_layout() const noexcept {
+    return vertex_layout_;
+}
+
+void IWindingNumberAlgorithm::vertex_layout(poly::VertexLayout vertex_layout) noexcept {
+    vertex_layout_ = vertex_layout;
+}
+
 std::string IWindingNumberAlgorithm::error_message() const noexcept {
     return error_message_;
 }
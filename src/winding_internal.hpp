@@ -0,0 +1,157 @@
+#ifndef WINDING_INTERNAL_HPP_
+#define WINDING_INTERNAL_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+
+// Geometry helpers shared between the winding number engines. Every engine must agree with
+// SimpleWindingNumberAlgorithm edge for edge, so the per-edge rules live here rather than in any one engine.
+
+namespace winding_number {
+namespace internal {
+
+// For convenience, not strictly necessary.
+struct Point {
+    float x, y;
+};
+
+// Calculates the z-component of the cross product of the vectors created between: [a, b], [b, c]
+// where the z-component of those vectors is 0. The result is a scalar value that
+// indicates the directional relationship of c w.r.t. the line [a, b].
+// - less than 0: the line is moving clockwise about c.
+// - 0: c is somewhere along the line.
+// - greater than 0: the line is moving counter clockwise about
+inline float CrossProduct(const Point& a, const Point& b, const Point& c) {
+    return ((b.x - a.x) * (c.y - b.y)) - ((b.y - a.y) * (c.x - b.x));
+}
+
+// A convenience method that extracts the n'th x and y values from the given
+// polygon and returns them in point-form.
+inline Point ExtractPoint(const poly::Polygon& polygon, size_t n) {
+    return {polygon.x_vec_.at(n), polygon.y_vec_.at(n)};
+}
+
+// Specifies if the given poitns are within tolerance range in both cardinal direction
+inline bool WithinTolerance(float tolerance, const Point& a, const Point& b) {
+    return (std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance);
+}
+
+// Typical fuzzy check, checks for equality out to the n'th decimal.
+inline bool FuzzyEquals(float a, float b, float max_delta = 1e-6f) {
+    return (std::abs(a - b) <= max_delta);
+}
+
+// The change in winding number contributed by the edge [a, b] for a ray cast up out of p.
+//
+// This is the body of SimpleWindingNumberAlgorithm's edge loop: a point on an upward vertical edge counts as inside,
+// otherwise only edges crossing p's x coordinate contribute, and points on the edge are treated as left of it.
+inline int EdgeContribution(const Point& a, const Point& b, const Point& p) {
+    bool a_left_or_on_p = a.x <= p.x;
+    bool b_left_or_on_p = b.x <= p.x;
+    auto cross_product = CrossProduct(a, b, p);
+    if (FuzzyEquals(cross_product, 0) && FuzzyEquals(a.x, b.x) && a.y < b.y && p.y <= b.y && a.y <= p.y) {
+        // the test point is on a vertically traversing edge
+        return 1;
+    } else if (a_left_or_on_p) {
+        // left to right motion, moving clockwise if to right.
+        return (!b_left_or_on_p && cross_product < 0) ? -1 : 0;
+    }
+    // right to left motion, moving ccw if to left or on the line.
+    return (b_left_or_on_p && cross_product >= 0) ? 1 : 0;
+}
+
+// Sums EdgeContribution() over the edges of a normalized polygon, given as a view in any of the layouts of
+// polygon_layout.hpp.
+template <typename View>
+int ScanWindingNumber(const View& polygon, const Point& p) {
+    Point a = {polygon.x(0), polygon.y(0)};
+    int winding_number = 0;
+    for (size_t i = 1; i < polygon.size(); ++i) {
+        Point b = {polygon.x(i), polygon.y(i)};
+        winding_number += EdgeContribution(a, b, p);
+        a = b;
+    }
+    return winding_number;
+}
+
+// The range of query x coordinates for which EdgeContribution(a, b, p) can be non-zero. An upward edge that is vertical
+// up to FuzzyEquals() also picks up points whose cross product with it rounds to zero, so its range is widened by the
+// distance at which that can still happen (which grows as the edge gets shorter).
+inline void EdgeXExtent(const Point& a, const Point& b, float& lo, float& hi) {
+    lo = std::min(a.x, b.x);
+    hi = std::max(a.x, b.x);
+    if (FuzzyEquals(a.x, b.x) && a.y < b.y) {
+        float slack = 2e-6f * (1.f + 1.f / (b.y - a.y));
+        lo -= slack;
+        hi += slack;
+    }
+}
+
+// Intervals sorted by their low end can be searched as an implicit tree: the subtree covering the half-open index range
+// [first, last) is rooted at its midpoint, and records the largest high end beneath it.
+inline size_t SubtreeRoot(size_t first, size_t last) {
+    return first + (last - first) / 2;
+}
+
+// Fills subtree_high_x with the largest high end in every subtree of [first, last), returning the one of the range.
+inline float BuildSubtreeHighX(const std::vector<float>& high_x, std::vector<float>& subtree_high_x, size_t first,
+                               size_t last) {
+    if (first >= last) {
+        return -std::numeric_limits<float>::infinity();
+    }
+    size_t root = SubtreeRoot(first, last);
+    float high = std::max({high_x[root], BuildSubtreeHighX(high_x, subtree_high_x, first, root),
+                           BuildSubtreeHighX(high_x, subtree_high_x, root + 1, last)});
+    subtree_high_x[root] = high;
+    return high;
+}
+
+// A point strictly inside the polygon, away from its boundary where that is possible. Crosses the polygon with a
+// horizontal line between two vertex heights near the middle of the polygon, and picks the midpoint of the widest span
+// of that line with a non-zero winding number. Falls back to the first vertex for polygons without any area.
+inline std::pair<float, float> InteriorPoint(const poly::Polygon& polygon, const IPreparedPolygon& prepared) {
+    const auto& x_vec = polygon.x_vec_;
+    const auto& y_vec = polygon.y_vec_;
+    std::vector<float> heights(y_vec);
+    std::sort(heights.begin(), heights.end());
+    heights.erase(std::unique(heights.begin(), heights.end()), heights.end());
+    if (heights.size() < 2) {
+        return {x_vec[0], y_vec[0]};
+    }
+    float center = 0.5f * (heights.front() + heights.back());
+    size_t above = std::upper_bound(heights.begin(), heights.end(), center) - heights.begin();
+    above = std::min(std::max(above, size_t(1)), heights.size() - 1);
+    float y = 0.5f * (heights[above - 1] + heights[above]);
+
+    std::vector<float> crossings;
+    for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+        float ay = y_vec[i], by = y_vec[i + 1];
+        if ((ay < y) != (by < y)) {
+            crossings.push_back(x_vec[i] + (y - ay) * (x_vec[i + 1] - x_vec[i]) / (by - ay));
+        }
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    std::pair<float, float> best = {x_vec[0], y_vec[0]};
+    float best_width = 0.f;
+    for (size_t i = 0; i + 1 < crossings.size(); ++i) {
+        float width = crossings[i + 1] - crossings[i];
+        float x = 0.5f * (crossings[i] + crossings[i + 1]);
+        if (width > best_width && prepared.CalculateWindingNumber2D(x, y) != 0) {
+            best = {x, y};
+            best_width = width;
+        }
+    }
+    return best;
+}
+
+}  // namespace internal
+}  // namespace winding_number
+
+#endif
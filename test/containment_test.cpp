@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <containment.hpp>
+#include <poly_io.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+using poly::PolygonSet;
+
+class ContainmentHierarchyTest : public ::testing::Test {
+protected:
+    ContainmentHierarchyTest() : algorithm_(IWindingNumberAlgorithm::Create()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    static Polygon MakeRectangle(float min_x, float min_y, float max_x, float max_y) {
+        Polygon p;
+        p.AppendPoint(min_x, min_y);
+        p.AppendPoint(max_x, min_y);
+        p.AppendPoint(max_x, max_y);
+        p.AppendPoint(min_x, max_y);
+        p.AppendPoint(min_x, min_y);
+        return p;
+    }
+
+    // A country split into a grid of states, each split into a grid of counties, with shared borders throughout. The
+    // polygons are appended in shuffled order, so the hierarchy cannot rely on the input order.
+    static PolygonSet MakeMap() {
+        std::vector<Polygon> polygons;
+        polygons.push_back(MakeRectangle(0.f, 0.f, 8.f, 8.f));
+        for (int state = 0; state < 4; ++state) {
+            float x = 4.f * (state % 2), y = 4.f * (state / 2);
+            polygons.push_back(MakeRectangle(x, y, x + 4.f, y + 4.f));
+            for (int county = 0; county < 4; ++county) {
+                float cx = x + 2.f * (county % 2), cy = y + 2.f * (county / 2);
+                polygons.push_back(MakeRectangle(cx, cy, cx + 2.f, cy + 2.f));
+            }
+        }
+        polygons.push_back(MakeRectangle(20.f, 20.f, 21.f, 21.f));  // An island outside the country.
+
+        PolygonSet set;
+        for (size_t i = 0; i < polygons.size(); ++i) {
+            set.AppendPolygon(polygons[(i * 7) % polygons.size()]);
+        }
+        return set;
+    }
+
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+};
+
+TEST_F(ContainmentHierarchyTest, BuildsNestedTree) {
+    PolygonSet set = MakeMap();
+    auto hierarchy = ContainmentHierarchy::Build(set, *algorithm_);
+    ASSERT_NE(nullptr, hierarchy);
+    EXPECT_EQ(set.size(), hierarchy->size());
+    EXPECT_EQ(3u, hierarchy->depth());
+    EXPECT_EQ(2u, hierarchy->roots().size());
+
+    size_t counties = 0;
+    for (size_t i = 0; i < hierarchy->size(); ++i) {
+        size_t parent = hierarchy->parent(i);
+        if (parent == ContainmentHierarchy::kNoParent) {
+            continue;
+        }
+        EXPECT_GE(set.polygons_[i].x_vec_[0], set.polygons_[parent].x_vec_[0]);
+        EXPECT_GE(set.polygons_[i].y_vec_[0], set.polygons_[parent].y_vec_[0]);
+        if (hierarchy->children(i).empty()) {
+            ++counties;
+        }
+    }
+    EXPECT_EQ(16u, counties);
+}
+
+TEST_F(ContainmentHierarchyTest, ReturnsChainOfContainingPolygons) {
+    PolygonSet set = MakeMap();
+    auto hierarchy = ContainmentHierarchy::Build(set, *algorithm_);
+    ASSERT_NE(nullptr, hierarchy);
+
+    auto chain = hierarchy->ContainingPolygons(5.5f, 1.5f);
+    ASSERT_EQ(3u, chain.size());
+    EXPECT_EQ(8.f, set.polygons_[chain[0]].x_vec_[1]);  // The country.
+    EXPECT_EQ(4.f, set.polygons_[chain[1]].x_vec_[0]);  // The south-east state.
+    EXPECT_EQ(4.f, set.polygons_[chain[2]].x_vec_[0]);  // Its south-west county.
+    EXPECT_EQ(2.f, set.polygons_[chain[2]].y_vec_[2]);
+    EXPECT_EQ(hierarchy->parent(chain[2]), chain[1]);
+    EXPECT_EQ(hierarchy->parent(chain[1]), chain[0]);
+
+    EXPECT_EQ(1u, hierarchy->ContainingPolygons(20.5f, 20.5f).size());
+    EXPECT_TRUE(hierarchy->ContainingPolygons(12.f, 12.f).empty());
+}
+
+TEST_F(ContainmentHierarchyTest, MatchesBruteForce) {
+    PolygonSet set = MakeMap();
+    auto hierarchy = ContainmentHierarchy::Build(set, *algorithm_);
+    ASSERT_NE(nullptr, hierarchy);
+
+    std::vector<size_t> chain;
+    for (float x = -0.75f; x < 9.f; x += 0.5f) {
+        for (float y = -0.75f; y < 9.f; y += 0.5f) {
+            hierarchy->ContainingPolygons(x, y, chain);
+            size_t containing = 0;
+            for (const auto& polygon : set.polygons_) {
+                containing += *algorithm_->CalculateWindingNumber2D(x, y, polygon) != 0;
+            }
+            EXPECT_EQ(containing, chain.size()) << x << ", " << y;
+        }
+    }
+}
+
+TEST_F(ContainmentHierarchyTest, ReportsPolygonsThatCannotBePrepared) {
+    PolygonSet set = MakeMap();
+    Polygon open;
+    open.AppendPoint(0.f, 0.f);
+    open.AppendPoint(1.f, 0.f);
+    open.AppendPoint(1.f, 1.f);
+    set.AppendPolygon(open);
+    EXPECT_EQ(nullptr, ContainmentHierarchy::Build(set, *algorithm_));
+    EXPECT_FALSE(algorithm_->error_message().empty());
+}
+
+}  // namespace winding_number
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <convex.hpp>
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class ConvexTest : public ::testing::Test {
+protected:
+    ConvexTest() :
+            reader_(poly::IPolygonReader::Create()),
+            algorithm_(IWindingNumberAlgorithm::Create()),
+            polygons_file_path_((std::filesystem::current_path() / "polygons.txt").string()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    // Random points on an ellipse, joined in angular order.
+    static Polygon MakeRandomConvex(std::mt19937& generator, size_t vertex_count, bool clockwise) {
+        std::uniform_real_distribution<float> angle(0.f, 2.f * float(M_PI));
+        std::vector<float> angles(vertex_count);
+        for (auto& a : angles) {
+            a = angle(generator);
+        }
+        std::sort(angles.begin(), angles.end());
+        if (clockwise) {
+            std::reverse(angles.begin(), angles.end());
+        }
+        Polygon p;
+        for (float a : angles) {
+            p.AppendPoint(1.f + 2.f * std::cos(a), 1.f + 1.5f * std::sin(a));
+        }
+        p.ClosePolygon();
+        return p;
+    }
+
+    static Polygon MakeRectangle(bool clockwise) {
+        Polygon p;
+        p.AppendPoint(0.0, 0.0);
+        if (clockwise) {
+            p.AppendPoint(0.0, 2.0);
+            p.AppendPoint(1.0, 2.0);
+            p.AppendPoint(3.0, 2.0);
+            p.AppendPoint(3.0, 0.0);
+        } else {
+            p.AppendPoint(3.0, 0.0);
+            p.AppendPoint(3.0, 1.0);  // A vertical run that normalization keeps.
+            p.AppendPoint(3.0, 2.0);
+            p.AppendPoint(0.0, 2.0);
+        }
+        p.ClosePolygon();
+        return p;
+    }
+
+    // Compares the engine with a scan on a grid and on the polygon's vertices and edge midpoints, one at a time and in
+    // batches.
+    void ExpectMatchesScan(const Polygon& polygon) {
+        auto scan = algorithm_->Prepare(polygon, Engine::kScan);
+        auto convex = algorithm_->Prepare(polygon, Engine::kConvex);
+        ASSERT_TRUE(scan);
+        ASSERT_TRUE(convex);
+        EXPECT_EQ(Engine::kConvex, convex->engine());
+
+        std::vector<float> xs, ys;
+        for (float x = -1.5f; x <= 4.5f; x += 0.125f) {
+            for (float y = -1.5f; y <= 4.5f; y += 0.125f) {
+                xs.push_back(x);
+                ys.push_back(y);
+            }
+        }
+        for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+            xs.push_back(polygon.x_vec_[i]);
+            ys.push_back(polygon.y_vec_[i]);
+            xs.push_back(0.5f * (polygon.x_vec_[i] + polygon.x_vec_[i + 1]));
+            ys.push_back(0.5f * (polygon.y_vec_[i] + polygon.y_vec_[i + 1]));
+        }
+        std::vector<int> batch(xs.size());
+        convex->CalculateWindingNumbers2D(xs.data(), ys.data(), xs.size(), batch.data());
+        for (size_t i = 0; i < xs.size(); ++i) {
+            int expected = scan->CalculateWindingNumber2D(xs[i], ys[i]);
+            EXPECT_EQ(expected, convex->CalculateWindingNumber2D(xs[i], ys[i])) << "at (" << xs[i] << ", " << ys[i] << ")";
+            EXPECT_EQ(expected, batch[i]) << "batch at (" << xs[i] << ", " << ys[i] << ")";
+        }
+    }
+
+    std::unique_ptr<poly::IPolygonReader> reader_;
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+    const std::string polygons_file_path_;
+};
+
+TEST_F(ConvexTest, DetectsConvexity) {
+    std::mt19937 generator(11);
+    EXPECT_TRUE(ConvexPolygon::IsConvex(MakeRandomConvex(generator, 40, false)));
+    EXPECT_TRUE(ConvexPolygon::IsConvex(MakeRandomConvex(generator, 40, true)));
+    EXPECT_TRUE(ConvexPolygon::IsConvex(MakeRectangle(false)));
+
+    Polygon dented = MakeRectangle(false);
+    dented.y_vec_[2] = 1.f;
+    dented.x_vec_[2] = 2.f;
+    EXPECT_FALSE(ConvexPolygon::IsConvex(dented));
+
+    Polygon pentagram;
+    for (int i = 0; i <= 5; ++i) {
+        float angle = 4.f * float(M_PI) * i / 5;
+        pentagram.AppendPoint(std::cos(angle), std::sin(angle));
+    }
+    EXPECT_FALSE(ConvexPolygon::IsConvex(pentagram));
+    EXPECT_FALSE(algorithm_->Prepare(pentagram, Engine::kConvex));
+    EXPECT_FALSE(algorithm_->error_message().empty());
+}
+
+TEST_F(ConvexTest, MatchesScan) {
+    std::mt19937 generator(3);
+    for (bool clockwise : {false, true}) {
+        ExpectMatchesScan(MakeRectangle(clockwise));
+        for (size_t vertex_count : {3, 5, 17, 64, 300}) {
+            ExpectMatchesScan(MakeRandomConvex(generator, vertex_count, clockwise));
+        }
+    }
+}
+
+TEST_F(ConvexTest, SelectedAutomaticallyForConvexPolygons) {
+    std::mt19937 generator(5);
+    auto convex = algorithm_->Prepare(MakeRandomConvex(generator, 64, true));
+    ASSERT_TRUE(convex);
+    EXPECT_EQ(Engine::kConvex, convex->engine());
+    EXPECT_EQ(true, convex->simple());
+    EXPECT_EQ(-1, static_cast<const ConvexPolygon&>(*convex).orientation());
+
+    auto points_and_polygons = reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_);
+    for (const auto& [x, y, polygon] : points_and_polygons) {
+        auto prepared = algorithm_->Prepare(polygon);
+        if (!prepared) continue;
+        auto expected = algorithm_->CalculateWindingNumber2D(x, y, polygon);
+        EXPECT_EQ(*expected, prepared->CalculateWindingNumber2D(x, y));
+    }
+}
+
+}  // namespace winding_number
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <edge_interval_tree.hpp>
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+#include "engine_test.hpp"
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class EdgeIntervalTreeTest : public EngineTest {
+protected:
+    // A spiky star with alternating inner and outer radii, so that no x-monotone run is longer than a couple of edges.
+    static Polygon MakeStar(int spikes) {
+        Polygon p;
+        for (int i = 0; i < 2 * spikes; ++i) {
+            float angle = float(M_PI) * i / spikes;
+            float radius = (i % 2 == 0) ? 3.f : 1.f;
+            p.AppendPoint(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        p.ClosePolygon();
+        return p;
+    }
+
+    // A strip with leaning teeth along its top. Every edge heads the other way in x from the last one, and no single
+    // point sees all of the teeth, so neither the chain nor the star engine applies.
+    static Polygon MakeSawtooth(int teeth) {
+        Polygon p;
+        for (int i = 0; i < teeth; ++i) {
+            p.AppendPoint(2.f * i, 3.f);
+            p.AppendPoint(2.f * i + 2.5f, 1.f);
+        }
+        p.AppendPoint(2.f * teeth, 3.f);
+        p.AppendPoint(2.f * teeth + 3.f, 0.f);
+        p.AppendPoint(0.f, 0.f);
+        p.ClosePolygon();
+        return p;
+    }
+};
+
+TEST_F(EdgeIntervalTreeTest, MatchesScanOnFilePolygons) {
+    ExpectMatchesScanOnFilePolygons(Engine::kEdgeIntervalTree);
+}
+
+TEST_F(EdgeIntervalTreeTest, MatchesScanOnLargeStar) {
+    Polygon star = MakeStar(500);
+    auto scan = algorithm_->Prepare(star, Engine::kScan);
+    auto normalized = algorithm_->Normalize(star);
+    ASSERT_TRUE(scan);
+    ASSERT_TRUE(normalized);
+    EdgeIntervalTreePolygon tree(normalized->polygon);
+    EXPECT_EQ(1000u, tree.edge_count());
+
+    for (float x = -3.2f; x <= 3.2f; x += 0.0173f) {
+        for (float y = -3.2f; y <= 3.2f; y += 0.31f) {
+            EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), tree.CalculateWindingNumber2D(x, y));
+        }
+    }
+    EXPECT_EQ(1, tree.CalculateWindingNumber2D(0.f, 0.f));
+    EXPECT_EQ(0, tree.CalculateWindingNumber2D(3.1f, 0.f));
+}
+
+TEST_F(EdgeIntervalTreeTest, AutomaticSelectionPrefersTreeForSpikyPolygons) {
+    auto prepared = algorithm_->Prepare(MakeSawtooth(100));
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ(Engine::kEdgeIntervalTree, prepared->engine());
+}
+
+}  // namespace winding_number
@@ -0,0 +1,86 @@
+#ifndef ENGINE_TEST_HPP_
+#define ENGINE_TEST_HPP_
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+// Shared by the tests of the prepared engines, which all have to agree with Engine::kScan exactly.
+class EngineTest : public ::testing::Test {
+protected:
+    using Points = std::vector<std::pair<float, float>>;
+
+    EngineTest() :
+            reader_(poly::IPolygonReader::Create()),
+            algorithm_(IWindingNumberAlgorithm::Create()),
+            polygons_file_path_((std::filesystem::current_path() / "polygons.txt").string()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    // The points of a square grid over [lo, hi] in both directions.
+    static Points Grid(float lo, float hi, float step) {
+        Points points;
+        for (float x = lo; x <= hi; x += step) {
+            for (float y = lo; y <= hi; y += step) {
+                points.emplace_back(x, y);
+            }
+        }
+        return points;
+    }
+
+    // Expects the engine to give the winding number the scan gives for each polygon at each point, and at every vertex
+    // and edge midpoint of the polygon, where engines that approximate the boundary are most likely to go wrong.
+    // Polygons the scan cannot prepare are skipped.
+    void ExpectMatchesScan(Engine engine, const std::vector<poly::Polygon>& polygons, const Points& points) const {
+        for (size_t p = 0; p < polygons.size(); ++p) {
+            const poly::Polygon& polygon = polygons[p];
+            auto scan = algorithm_->Prepare(polygon, Engine::kScan);
+            auto prepared = algorithm_->Prepare(polygon, engine);
+            if (!scan) continue;
+            ASSERT_TRUE(prepared) << "polygon " << p;
+            EXPECT_EQ(engine, prepared->engine()) << "polygon " << p;
+
+            Points queries = points;
+            for (size_t i = 0; i < polygon.size(); ++i) {
+                size_t next = (i + 1) % polygon.size();
+                queries.emplace_back(polygon.x_vec_[i], polygon.y_vec_[i]);
+                queries.emplace_back(0.5f * (polygon.x_vec_[i] + polygon.x_vec_[next]),
+                                     0.5f * (polygon.y_vec_[i] + polygon.y_vec_[next]));
+            }
+            for (const auto& [x, y] : queries) {
+                EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), prepared->CalculateWindingNumber2D(x, y))
+                        << "polygon " << p << " at (" << x << ", " << y << ")";
+            }
+        }
+    }
+
+    // ExpectMatchesScan() over the polygons of polygons.txt, at their own points and on a grid around them.
+    void ExpectMatchesScanOnFilePolygons(Engine engine) const {
+        std::vector<poly::Polygon> polygons;
+        Points points = Grid(-1.5f, 4.5f, 0.25f);
+        for (auto& [x, y, polygon] : reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_)) {
+            points.emplace_back(x, y);
+            polygons.push_back(std::move(polygon));
+        }
+        ExpectMatchesScan(engine, polygons, points);
+    }
+
+    std::unique_ptr<poly::IPolygonReader> reader_;
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+    const std::string polygons_file_path_;
+};
+
+}  // namespace winding_number
+
+#endif
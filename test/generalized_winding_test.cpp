@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <generalized_winding.hpp>
+#include <poly_io.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class GeneralizedWindingNumberTest : public ::testing::Test {
+protected:
+    // A circle of radius 1 about the origin, counter-clockwise, with the last gap_vertices left out.
+    static Polygon MakeCircle(int vertex_count, int gap_vertices = 0) {
+        Polygon p;
+        for (int i = 0; i <= vertex_count - gap_vertices; ++i) {
+            float angle = 2.f * float(M_PI) * i / vertex_count;
+            p.AppendPoint(std::cos(angle), std::sin(angle));
+        }
+        return p;
+    }
+};
+
+TEST_F(GeneralizedWindingNumberTest, ClosedSquareIsExact) {
+    Polygon p;
+    p.AppendPoint(0.0, 0.0);
+    p.AppendPoint(1.0, 0.0);
+    p.AppendPoint(1.0, 1.0);
+    p.AppendPoint(0.0, 1.0);
+    p.AppendPoint(0.0, 0.0);
+    GeneralizedWindingNumber gwn(p);
+
+    EXPECT_NEAR(1.f, gwn.CalculateExact(0.5f, 0.5f), 1e-5f);
+    EXPECT_NEAR(0.f, gwn.CalculateExact(2.f, 0.5f), 1e-5f);
+    EXPECT_NEAR(0.5f, gwn.CalculateExact(0.5f, 0.f), 1e-5f);
+    EXPECT_EQ(1, gwn.CalculateWindingNumber2D(0.5f, 0.5f));
+    EXPECT_EQ(0, gwn.CalculateWindingNumber2D(-0.5f, 0.5f));
+}
+
+TEST_F(GeneralizedWindingNumberTest, ClassifiesSlightlyOpenBoundaries) {
+    // Closed polygons fail IsClosed() with a gap like this one, the generalized winding number does not care.
+    GeneralizedWindingNumber gwn(MakeCircle(1000, 5));
+    EXPECT_EQ(1, gwn.CalculateWindingNumber2D(0.f, 0.f));
+    EXPECT_EQ(1, gwn.CalculateWindingNumber2D(0.5f, -0.3f));
+    EXPECT_EQ(0, gwn.CalculateWindingNumber2D(1.5f, 0.f));
+    EXPECT_NEAR(0.995f, gwn.CalculateExact(0.f, 0.f), 1e-4f);
+}
+
+TEST_F(GeneralizedWindingNumberTest, ApproximationTracksExactSum) {
+    GeneralizedWindingNumber gwn(MakeCircle(20000, 40));
+    EXPECT_EQ(20000u - 40, gwn.edge_count());
+    EXPECT_GT(gwn.node_count(), 1u);
+
+    float loose_error = 0.f, tight_error = 0.f;
+    for (float x = -1.9f; x < 2.f; x += 0.37f) {
+        for (float y = -1.9f; y < 2.f; y += 0.41f) {
+            float exact = gwn.CalculateExact(x, y);
+            gwn.accuracy(2.f);
+            loose_error = std::max(loose_error, std::abs(gwn.Calculate(x, y) - exact));
+            gwn.accuracy(8.f);
+            tight_error = std::max(tight_error, std::abs(gwn.Calculate(x, y) - exact));
+        }
+    }
+    EXPECT_LT(loose_error, 1e-2f);
+    EXPECT_LT(tight_error, 1e-4f);
+    EXPECT_LE(tight_error, loose_error);
+}
+
+}  // namespace winding_number
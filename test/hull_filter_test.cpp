@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include <hull_filter.hpp>
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+#include "engine_test.hpp"
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class HullFilterTest : public EngineTest {
+protected:
+    // A disc of radius 5 about (3, 2) with a ragged, finely detailed boundary, like a coastline around an island.
+    static Polygon MakeIsland(bool clockwise = false) {
+        Polygon p;
+        const int count = 1500;
+        for (int i = 0; i <= count; ++i) {
+            float angle = 2.f * float(M_PI) * (i % count) / count * (clockwise ? -1.f : 1.f);
+            float radius = 5.f + 0.3f * std::sin(angle * 97.f) + 0.2f * std::cos(angle * 301.f);
+            p.AppendPoint(3.f + radius * std::cos(angle), 2.f + radius * std::sin(angle));
+        }
+        return p;
+    }
+};
+
+TEST_F(HullFilterTest, MatchesScanOnFilePolygons) {
+    ExpectMatchesScanOnFilePolygons(Engine::kHullFilter);
+}
+
+TEST_F(HullFilterTest, MatchesScanOnIsland) {
+    for (bool clockwise : {false, true}) {
+        Polygon island = MakeIsland(clockwise);
+        auto scan = algorithm_->Prepare(island, Engine::kScan);
+        ASSERT_TRUE(scan);
+        auto normalized = algorithm_->Normalize(island);
+        ASSERT_TRUE(normalized);
+        HullFilteredPolygon hulls(normalized->polygon, algorithm_->Prepare(island, Engine::kScan));
+        EXPECT_EQ(clockwise ? -1 : 1, hulls.inner_winding_number());
+        EXPECT_EQ(1.f, hulls.inner_coverage());
+
+        for (float x = -3.f; x <= 9.f; x += 0.173f) {
+            for (float y = -4.f; y <= 8.f; y += 0.211f) {
+                EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), hulls.CalculateWindingNumber2D(x, y))
+                        << "at (" << x << ", " << y << ")";
+            }
+        }
+        for (size_t i = 0; i < island.size(); i += 7) {
+            float x = island.x_vec_[i], y = island.y_vec_[i];
+            EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), hulls.CalculateWindingNumber2D(x, y));
+        }
+    }
+}
+
+TEST_F(HullFilterTest, ReportsEarlyResolutions) {
+    auto normalized = algorithm_->Normalize(MakeIsland());
+    ASSERT_TRUE(normalized);
+    HullFilteredPolygon hulls(normalized->polygon, algorithm_->Prepare(normalized->polygon, Engine::kScan));
+    HullFilterStatistics statistics;
+    EXPECT_EQ(0.f, statistics.early_resolution_fraction());
+
+    EXPECT_EQ(1, hulls.CalculateWindingNumber2D(3.f, 2.f, statistics));   // Deep inside.
+    EXPECT_EQ(0, hulls.CalculateWindingNumber2D(20.f, 2.f, statistics));  // Far outside.
+    EXPECT_EQ(2u, statistics.resolved_early_count);
+    hulls.CalculateWindingNumber2D(3.f + 5.f, 2.f, statistics);           // In the ragged band.
+    hulls.CalculateWindingNumber2D(3.f, 2.f);                             // Not counted.
+    EXPECT_EQ(3u, statistics.query_count);
+    EXPECT_EQ(2u, statistics.resolved_early_count);
+
+    statistics = {};
+    for (float x = -3.f; x <= 9.f; x += 0.1f) {
+        for (float y = -4.f; y <= 8.f; y += 0.1f) {
+            EXPECT_EQ(hulls.CalculateWindingNumber2D(x, y), hulls.CalculateWindingNumber2D(x, y, statistics));
+        }
+    }
+    // The band between the hulls is a ring of width 1 or so against a 12 x 12 query area.
+    EXPECT_GT(statistics.early_resolution_fraction(), 0.6f);
+    EXPECT_LT(statistics.early_resolution_fraction(), 1.f);
+}
+
+TEST_F(HullFilterTest, MatchesScanAtVerticesOnSectorRays) {
+    // The interior point of this polygon is (-1.5, 0.5), which puts the vertex (0, -1) exactly on the -45 degree ray
+    // between two sectors.
+    const float coordinates[][2] = {
+            {-1, 9}, {-1, 3}, {-1, 2}, {-2, 4}, {-1, 2}, {-5, 7}, {-4, 4},  {-1, 1}, {-6, 4}, {-4, 3},  {-7, 3}, {-7, 2},
+            {-5, 1}, {-6, 0}, {-9, 0}, {-3, 0}, {-4, -1}, {-6, -2}, {-1, -1}, {-4, -3}, {-3, -4}, {-2, -6}, {-1, -9},
+            {0, -3}, {0, -5}, {1, -6}, {1, -7}, {1, -6},  {0, -1}, {5, -8}, {4, -4}, {3, -2},  {9, -4}, {2, -1},  {7, -3},
+            {1, 0},  {4, -1}, {3, -1}, {4, 1},  {1, 0},   {7, 2},  {2, 2},  {6, 6},  {1, 7},   {0, 3},  {-1, 9}};
+    Polygon polygon;
+    for (const auto& [x, y] : coordinates) {
+        polygon.AppendPoint(x, y);
+    }
+    auto scan = algorithm_->Prepare(polygon, Engine::kScan);
+    auto hulls = algorithm_->Prepare(polygon, Engine::kHullFilter);
+    ASSERT_TRUE(scan);
+    ASSERT_TRUE(hulls);
+    EXPECT_EQ(2, scan->CalculateWindingNumber2D(0.f, -1.f));
+    EXPECT_EQ(2, hulls->CalculateWindingNumber2D(0.f, -1.f));
+
+    // Small integer polygons put vertices on the sector rays of their interior point often.
+    std::mt19937 random(34);
+    std::uniform_int_distribution<int> coordinate(-9, 9);
+    for (int trial = 0; trial < 3000; ++trial) {
+        Polygon random_polygon;
+        for (int i = 0; i < 12; ++i) {
+            random_polygon.AppendPoint(float(coordinate(random)), float(coordinate(random)));
+        }
+        random_polygon.ClosePolygon();
+        auto random_scan = algorithm_->Prepare(random_polygon, Engine::kScan);
+        auto random_hulls = algorithm_->Prepare(random_polygon, Engine::kHullFilter);
+        if (!random_scan) continue;
+        ASSERT_TRUE(random_hulls);
+        for (size_t i = 0; i < random_polygon.size(); ++i) {
+            float x = random_polygon.x_vec_[i], y = random_polygon.y_vec_[i];
+            EXPECT_EQ(random_scan->CalculateWindingNumber2D(x, y), random_hulls->CalculateWindingNumber2D(x, y))
+                    << "trial " << trial << " at (" << x << ", " << y << ")";
+        }
+    }
+}
+
+}  // namespace winding_number
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <mesh.hpp>
+#include <mesh_winding.hpp>
+
+namespace winding_number {
+
+using poly::TriangleMesh;
+
+class MeshWindingNumberTest : public ::testing::Test {
+protected:
+    // The unit cube [0, 1]^3 with outward facing triangles.
+    static TriangleMesh MakeCube() {
+        TriangleMesh mesh;
+        for (int i = 0; i < 8; ++i) {
+            mesh.AppendVertex(float(i & 1), float((i >> 1) & 1), float((i >> 2) & 1));
+        }
+        const uint32_t faces[6][4] = {{0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+        for (const auto& face : faces) {
+            mesh.AppendTriangle(face[0], face[1], face[2]);
+            mesh.AppendTriangle(face[0], face[2], face[3]);
+        }
+        return mesh;
+    }
+
+    // A latitude/longitude sphere of radius 1 about the origin, with the given number of bands in each direction.
+    static TriangleMesh MakeSphere(int bands) {
+        TriangleMesh mesh;
+        for (int i = 0; i <= bands; ++i) {
+            float theta = float(M_PI) * i / bands;
+            for (int j = 0; j < 2 * bands; ++j) {
+                float phi = float(M_PI) * j / bands;
+                mesh.AppendVertex(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+            }
+        }
+        for (int i = 0; i < bands; ++i) {
+            for (int j = 0; j < 2 * bands; ++j) {
+                uint32_t a = i * 2 * bands + j, b = i * 2 * bands + (j + 1) % (2 * bands);
+                uint32_t c = a + 2 * bands, d = b + 2 * bands;
+                mesh.AppendTriangle(a, c, d);
+                mesh.AppendTriangle(a, d, b);
+            }
+        }
+        return mesh;
+    }
+};
+
+TEST_F(MeshWindingNumberTest, CubeIsExact) {
+    MeshWindingNumber winding(MakeCube());
+    EXPECT_EQ(12u, winding.triangle_count());
+    EXPECT_NEAR(1.f, winding.CalculateExact(0.5f, 0.5f, 0.5f), 1e-5f);
+    EXPECT_NEAR(1.f, winding.CalculateExact(0.1f, 0.9f, 0.2f), 1e-5f);
+    EXPECT_NEAR(0.f, winding.CalculateExact(1.5f, 0.5f, 0.5f), 1e-5f);
+    EXPECT_EQ(1, winding.CalculateWindingNumber3D(0.5f, 0.5f, 0.5f));
+    EXPECT_EQ(0, winding.CalculateWindingNumber3D(-3.f, 0.5f, 0.5f));
+}
+
+TEST_F(MeshWindingNumberTest, OpenMeshGivesFractionalValues) {
+    TriangleMesh mesh = MakeCube();
+    // Remove the top face, the center then sees five sixths of a closed surface.
+    mesh.triangles_.erase(mesh.triangles_.begin() + 6, mesh.triangles_.begin() + 12);
+    MeshWindingNumber winding(mesh);
+    EXPECT_NEAR(5.f / 6.f, winding.CalculateExact(0.5f, 0.5f, 0.5f), 1e-5f);
+    EXPECT_EQ(1, winding.CalculateWindingNumber3D(0.5f, 0.5f, 0.5f));
+}
+
+TEST_F(MeshWindingNumberTest, ApproximationTracksExactSum) {
+    MeshWindingNumber winding(MakeSphere(64));
+    EXPECT_GT(winding.node_count(), 1u);
+
+    float loose_error = 0.f, tight_error = 0.f;
+    for (float x = -1.7f; x < 1.8f; x += 0.43f) {
+        for (float z = -1.7f; z < 1.8f; z += 0.47f) {
+            float exact = winding.CalculateExact(x, 0.13f, z);
+            winding.accuracy(2.f);
+            loose_error = std::max(loose_error, std::abs(winding.Calculate(x, 0.13f, z) - exact));
+            winding.accuracy(6.f);
+            tight_error = std::max(tight_error, std::abs(winding.Calculate(x, 0.13f, z) - exact));
+        }
+    }
+    EXPECT_LT(loose_error, 1e-2f);
+    EXPECT_LT(tight_error, 1e-3f);
+    EXPECT_LE(tight_error, loose_error);
+}
+
+TEST_F(MeshWindingNumberTest, VoxelizesSphere) {
+    MeshWindingNumber winding(MakeSphere(32));
+    const size_t size = 20;
+    const float spacing = 0.125f;
+    auto grid = winding.CalculateVoxelGrid(-1.25f, -1.25f, -1.25f, spacing, size, size, size);
+    ASSERT_EQ(size * size * size, grid.size());
+
+    size_t inside = 0;
+    for (float value : grid) {
+        inside += value > 0.5f;
+    }
+    // The voxel count approximates the sphere's volume.
+    float volume = inside * spacing * spacing * spacing;
+    EXPECT_NEAR(4.f / 3.f * float(M_PI), volume, 0.2f);
+
+    std::vector<float> x = {0.f, 2.f}, y = {0.f, 0.f}, z = {0.f, 0.f}, results(2);
+    winding.Calculate(x.data(), y.data(), z.data(), 2, results.data());
+    EXPECT_NEAR(1.f, results[0], 1e-2f);
+    EXPECT_NEAR(0.f, results[1], 1e-2f);
+}
+
+}  // namespace winding_number
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <monotone_chain.hpp>
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+#include "engine_test.hpp"
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class MonotoneChainTest : public EngineTest {
+protected:
+    // A strip whose top edge is a long wiggly run heading left, the shape of a stretch of coastline.
+    static Polygon MakeCoastline() {
+        Polygon p;
+        p.AppendPoint(0.0, -5.0);
+        p.AppendPoint(100.0, -5.0);
+        for (float x = 100.f; x >= 0.f; x -= 0.5f) {
+            p.AppendPoint(x, std::sin(x));
+        }
+        p.AppendPoint(0.0, -5.0);
+        return p;
+    }
+};
+
+TEST_F(MonotoneChainTest, MatchesScanOnFilePolygons) {
+    ExpectMatchesScanOnFilePolygons(Engine::kMonotoneChain);
+}
+
+TEST_F(MonotoneChainTest, CoastlineSplitsIntoFewChains) {
+    auto normalized = algorithm_->Normalize(MakeCoastline());
+    ASSERT_TRUE(normalized);
+    MonotoneChainPolygon chains(normalized->polygon);
+    EXPECT_EQ(2u, chains.chain_count());
+    EXPECT_EQ(2u, chains.vertical_edge_count());
+    EXPECT_EQ(2u, MonotoneChainPolygon::CountChains(normalized->polygon));
+
+    EXPECT_EQ(1, chains.CalculateWindingNumber2D(50.25f, -2.f));
+    EXPECT_EQ(0, chains.CalculateWindingNumber2D(50.25f, 2.f));
+    EXPECT_EQ(1, chains.CalculateWindingNumber2D(0.f, -1.f));
+    EXPECT_EQ(0, chains.CalculateWindingNumber2D(-0.25f, -1.f));
+}
+
+TEST_F(MonotoneChainTest, AutomaticSelectionPrefersChainsForCoastlines) {
+    auto prepared = algorithm_->Prepare(MakeCoastline());
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ(Engine::kMonotoneChain, prepared->engine());
+
+    Polygon square;
+    square.AppendPoint(0.0, 0.0);
+    square.AppendPoint(1.0, 0.0);
+    square.AppendPoint(1.0, 1.0);
+    square.AppendPoint(0.0, 1.0);
+    square.AppendPoint(0.0, 0.0);
+    EXPECT_EQ(Engine::kScan, algorithm_->Prepare(square)->engine());
+}
+
+}  // namespace winding_number
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include <path.hpp>
+#include <path_winding.hpp>
+#include <poly_io.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Path;
+using poly::Polygon;
+
+class PathWindingNumberTest : public ::testing::Test {
+protected:
+    PathWindingNumberTest() : algorithm_(IWindingNumberAlgorithm::Create()) {}
+
+    // Adds a circle made of four cubic arcs, counter-clockwise unless reversed.
+    static void AddCircle(Path& path, float center_x, float center_y, float radius, bool reversed = false) {
+        const float k = 0.5522847f * radius;
+        float sign = reversed ? -1.f : 1.f;
+        path.MoveTo(center_x + radius, center_y);
+        path.CubicTo(center_x + radius, center_y + sign * k, center_x + k, center_y + sign * radius, center_x,
+                     center_y + sign * radius);
+        path.CubicTo(center_x - k, center_y + sign * radius, center_x - radius, center_y + sign * k, center_x - radius,
+                     center_y);
+        path.CubicTo(center_x - radius, center_y - sign * k, center_x - k, center_y - sign * radius, center_x,
+                     center_y - sign * radius);
+        path.CubicTo(center_x + k, center_y - sign * radius, center_x + radius, center_y - sign * k, center_x + radius,
+                     center_y);
+    }
+
+    // The flattening the engine is meant to replace.
+    static Polygon Flatten(const Path& path, int steps_per_curve) {
+        Polygon polygon;
+        size_t point = 0;
+        for (Path::Segment segment : path.segments_) {
+            size_t count = Path::PointCount(segment);
+            float x[4], y[4];
+            for (size_t i = 0; i <= count; ++i) {
+                x[i] = path.x_vec_[point + i];
+                y[i] = path.y_vec_[point + i];
+            }
+            if (polygon.size() == 0) {
+                polygon.AppendPoint(x[0], y[0]);
+            }
+            int steps = (segment == Path::Segment::kLine) ? 1 : steps_per_curve;
+            for (int step = 1; step <= steps; ++step) {
+                float t = float(step) / steps, s = 1 - t;
+                if (segment == Path::Segment::kCubic) {
+                    polygon.AppendPoint(s * s * s * x[0] + 3 * s * s * t * x[1] + 3 * s * t * t * x[2] + t * t * t * x[3],
+                                        s * s * s * y[0] + 3 * s * s * t * y[1] + 3 * s * t * t * y[2] + t * t * t * y[3]);
+                } else if (segment == Path::Segment::kQuadratic) {
+                    polygon.AppendPoint(s * s * x[0] + 2 * s * t * x[1] + t * t * x[2],
+                                        s * s * y[0] + 2 * s * t * y[1] + t * t * y[2]);
+                } else {
+                    polygon.AppendPoint(x[1], y[1]);
+                }
+            }
+            point += count;
+        }
+        polygon.ClosePolygon();
+        return polygon;
+    }
+
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+};
+
+TEST_F(PathWindingNumberTest, QuadraticArch) {
+    Path path;
+    path.MoveTo(0.0, 0.0);
+    path.QuadraticTo(1.0, 2.0, 2.0, 0.0);
+    path.ClosePath();
+    EXPECT_EQ(2u, path.segment_count());
+
+    // The arch runs left to right over the top, so it winds clockwise.
+    PathWindingNumber winding(path);
+    EXPECT_EQ(-1, winding.CalculateWindingNumber2D(1.f, 0.5f));
+    EXPECT_EQ(-1, winding.CalculateWindingNumber2D(0.2f, 0.3f));
+    EXPECT_EQ(0, winding.CalculateWindingNumber2D(0.2f, 0.4f));
+    EXPECT_EQ(0, winding.CalculateWindingNumber2D(1.f, 1.2f));
+    EXPECT_EQ(0, winding.CalculateWindingNumber2D(1.f, -0.5f));
+}
+
+TEST_F(PathWindingNumberTest, SplitsCurvesIntoMonotonePieces) {
+    Path path;
+    path.MoveTo(0.0, 0.0);
+    // An s-bend that heads right, back left, then right again.
+    path.CubicTo(3.0, 1.0, -1.0, 2.0, 2.0, 3.0);
+    path.LineTo(0.0, 3.0);
+    path.ClosePath();
+
+    PathWindingNumber winding(path);
+    EXPECT_EQ(5u, winding.piece_count());
+    Polygon flattened = Flatten(path, 500);
+    for (float x = -0.9f; x < 2.5f; x += 0.07f) {
+        for (float y = 0.03f; y < 3.f; y += 0.11f) {
+            EXPECT_EQ(*algorithm_->CalculateWindingNumber2D(x, y, flattened), winding.CalculateWindingNumber2D(x, y))
+                    << "at (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST_F(PathWindingNumberTest, MatchesFlatteningAwayFromTheOutline) {
+    // A ring: an outer circle with a clockwise hole, the way fonts draw an 'o'.
+    Path path;
+    AddCircle(path, 0.f, 0.f, 2.f);
+    AddCircle(path, 0.2f, 0.f, 1.f, true);
+    EXPECT_EQ(2u, path.contour_count());
+
+    PathWindingNumber winding(path);
+    Polygon outer, inner;
+    {
+        Path outer_path, inner_path;
+        AddCircle(outer_path, 0.f, 0.f, 2.f);
+        AddCircle(inner_path, 0.2f, 0.f, 1.f, true);
+        outer = Flatten(outer_path, 200);
+        inner = Flatten(inner_path, 200);
+    }
+    for (float x = -2.5f; x < 2.5f; x += 0.093f) {
+        for (float y = -2.5f; y < 2.5f; y += 0.087f) {
+            float outer_distance = std::abs(std::hypot(x, y) - 2.f);
+            float inner_distance = std::abs(std::hypot(x - 0.2f, y) - 1.f);
+            if (outer_distance < 1e-2f || inner_distance < 1e-2f) continue;
+            int expected = *algorithm_->CalculateWindingNumber2D(x, y, outer) +
+                           *algorithm_->CalculateWindingNumber2D(x, y, inner);
+            EXPECT_EQ(expected, winding.CalculateWindingNumber2D(x, y)) << "at (" << x << ", " << y << ")";
+        }
+    }
+    EXPECT_EQ(1, winding.CalculateWindingNumber2D(-1.5f, 0.f));
+    EXPECT_EQ(0, winding.CalculateWindingNumber2D(0.2f, 0.f));
+}
+
+}  // namespace winding_number
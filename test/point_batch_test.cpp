@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <point_batch.hpp>
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class PointBatchTest : public ::testing::Test {
+protected:
+    PointBatchTest() :
+            reader_(poly::IPolygonReader::Create()),
+            algorithm_(IWindingNumberAlgorithm::Create()),
+            polygons_file_path_((std::filesystem::current_path() / "polygons.txt").string()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    // A star with alternating inner and outer radii, going around the origin the given number of times.
+    static Polygon MakeStar(size_t points, int turns) {
+        Polygon p;
+        for (size_t i = 0; i < 2 * points; ++i) {
+            float angle = float(turns) * float(M_PI) * float(i) / float(points);
+            float radius = i % 2 ? 1.f : 2.f;
+            p.AppendPoint(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        p.ClosePolygon();
+        return p;
+    }
+
+    // Compares batches of every length up to a few blocks, so that full and padded blocks are both covered, against a
+    // scan of the same points.
+    void ExpectMatchesScan(const Polygon& polygon) {
+        auto scan = algorithm_->Prepare(polygon, Engine::kScan);
+        auto point_batch = algorithm_->Prepare(polygon, Engine::kPointBatch);
+        ASSERT_TRUE(scan);
+        ASSERT_TRUE(point_batch);
+        EXPECT_EQ(Engine::kPointBatch, point_batch->engine());
+
+        std::vector<float> xs, ys;
+        for (float x = -2.5f; x <= 2.5f; x += 0.125f) {
+            for (float y = -2.5f; y <= 2.5f; y += 0.125f) {
+                xs.push_back(x);
+                ys.push_back(y);
+            }
+        }
+        for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+            xs.push_back(polygon.x_vec_[i]);
+            ys.push_back(polygon.y_vec_[i]);
+            xs.push_back(0.5f * (polygon.x_vec_[i] + polygon.x_vec_[i + 1]));
+            ys.push_back(0.5f * (polygon.y_vec_[i] + polygon.y_vec_[i + 1]));
+        }
+        std::vector<int> batch(xs.size());
+        point_batch->CalculateWindingNumbers2D(xs.data(), ys.data(), xs.size(), batch.data());
+        for (size_t i = 0; i < xs.size(); ++i) {
+            int expected = scan->CalculateWindingNumber2D(xs[i], ys[i]);
+            EXPECT_EQ(expected, point_batch->CalculateWindingNumber2D(xs[i], ys[i]))
+                    << "at (" << xs[i] << ", " << ys[i] << ")";
+            EXPECT_EQ(expected, batch[i]) << "batch at (" << xs[i] << ", " << ys[i] << ")";
+        }
+
+        size_t offset = xs.size() / 2;
+        for (size_t count = 0; count <= 3 * PointBatchPolygon::block_size() + 1; ++count) {
+            std::vector<int> partial(count + 1, -99);
+            point_batch->CalculateWindingNumbers2D(xs.data() + offset, ys.data() + offset, count, partial.data());
+            for (size_t i = 0; i < count; ++i) {
+                EXPECT_EQ(batch[offset + i], partial[i]) << "batch of " << count;
+            }
+            EXPECT_EQ(-99, partial[count]) << "batch of " << count << " wrote past its end";
+        }
+    }
+
+    std::unique_ptr<poly::IPolygonReader> reader_;
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+    const std::string polygons_file_path_;
+};
+
+TEST_F(PointBatchTest, MatchesScan) {
+    ExpectMatchesScan(MakeStar(5, 2));
+    ExpectMatchesScan(MakeStar(7, 3));
+    ExpectMatchesScan(MakeStar(24, 2));
+
+    std::mt19937 generator(39);
+    std::uniform_real_distribution<float> coordinate(-2.f, 2.f);
+    Polygon random;
+    for (int i = 0; i < 20; ++i) {
+        random.AppendPoint(coordinate(generator), coordinate(generator));
+    }
+    random.ClosePolygon();
+    ExpectMatchesScan(random);
+}
+
+TEST_F(PointBatchTest, MatchesScanOnFile) {
+    auto points_and_polygons = reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_);
+    ASSERT_FALSE(points_and_polygons.empty());
+    for (const auto& [x, y, polygon] : points_and_polygons) {
+        auto scan = algorithm_->Prepare(polygon, Engine::kScan);
+        auto point_batch = algorithm_->Prepare(polygon, Engine::kPointBatch);
+        ASSERT_EQ(bool(scan), bool(point_batch));
+        if (point_batch) {
+            int winding_number = 0;
+            point_batch->CalculateWindingNumbers2D(&x, &y, 1, &winding_number);
+            EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), winding_number);
+        }
+    }
+}
+
+TEST_F(PointBatchTest, TiledBatchesMatchScan) {
+    EXPECT_GT(PointBatchPolygon::edge_tile_size(), 0u);
+    EXPECT_EQ(0u, PointBatchPolygon::point_tile_size() % PointBatchPolygon::block_size());
+
+    // Enough edges for several edge tiles, so that partial counts are carried from one tile to the next.
+    Polygon star = MakeStar(2 * PointBatchPolygon::edge_tile_size() + 7, 3);
+    auto scan = algorithm_->Prepare(star, Engine::kScan);
+    auto point_batch = algorithm_->Prepare(star, Engine::kPointBatch);
+    ASSERT_TRUE(scan);
+    ASSERT_TRUE(point_batch);
+
+    std::vector<float> xs, ys;
+    for (float x = -2.25f; x <= 2.25f; x += 0.25f) {
+        for (float y = -2.25f; y <= 2.25f; y += 0.25f) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+    std::vector<int> batch(xs.size());
+    point_batch->CalculateWindingNumbers2D(xs.data(), ys.data(), xs.size(), batch.data());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        EXPECT_EQ(scan->CalculateWindingNumber2D(xs[i], ys[i]), batch[i]) << "at (" << xs[i] << ", " << ys[i] << ")";
+    }
+}
+
+TEST_F(PointBatchTest, SelectedAutomaticallyForLargeBatches) {
+    Polygon star = MakeStar(5, 1);
+    EXPECT_NE(Engine::kPointBatch, algorithm_->Prepare(star)->engine());
+    EXPECT_NE(Engine::kPointBatch, algorithm_->Prepare(star, Engine::kAutomatic, 8)->engine());
+    EXPECT_EQ(Engine::kPointBatch, algorithm_->Prepare(star, Engine::kAutomatic, 1000)->engine());
+
+    // Polygons this large are better served by an index however many points come at once.
+    EXPECT_NE(Engine::kPointBatch, algorithm_->Prepare(MakeStar(100, 1), Engine::kAutomatic, 1000000)->engine());
+}
+
+}  // namespace winding_number
@@ -2,12 +2,39 @@
 #include <poly_io.hpp>
 
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <random>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <vector>
+
+#if defined(WINDING_NUMBER_HAVE_ZLIB)
+#include <zlib.h>
+#endif
 
 namespace poly {
 
+#if defined(WINDING_NUMBER_HAVE_ZLIB)
+// Compresses text into a single gzip member.
+static std::string Gzip(std::string text) {
+    z_stream stream = {};
+    EXPECT_EQ(Z_OK, deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY));
+    std::string member(deflateBound(&stream, uLong(text.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(text.data());
+    stream.avail_in = uInt(text.size());
+    stream.next_out = reinterpret_cast<Bytef*>(member.data());
+    stream.avail_out = uInt(member.size());
+    EXPECT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+    member.resize(stream.total_out);
+    deflateEnd(&stream);
+    return member;
+}
+#endif
+
 class PolygonTest : public ::testing::Test {
 protected:
     PolygonTest() :
@@ -15,6 +42,56 @@ protected:
             polygons_file_path_((std::filesystem::current_path() / "polygons.txt").string()),
             polygons_crlf_file_path_((std::filesystem::current_path() / "crlf_polygons.txt").string()) {}
 
+#if defined(WINDING_NUMBER_HAVE_ZLIB) || defined(WINDING_NUMBER_HAVE_ZSTD)
+    // Expects polygons.txt compressed into a single member at compressed_path to read like polygons.txt itself, also
+    // when the member is repeated, and expects a truncated copy to be rejected.
+    void ExpectReadsCompressedFile(const std::string& compressed_path) {
+        auto expected = reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_);
+        auto polygons = reader_->ReadPointsAndPolygonsFromFile(compressed_path);
+        ASSERT_EQ(expected.size(), polygons.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(std::get<0>(expected[i]), std::get<0>(polygons[i]));
+            EXPECT_EQ(std::get<1>(expected[i]), std::get<1>(polygons[i]));
+            EXPECT_EQ(std::get<2>(expected[i]).x_vec_, std::get<2>(polygons[i]).x_vec_);
+            EXPECT_EQ(std::get<2>(expected[i]).y_vec_, std::get<2>(polygons[i]).y_vec_);
+        }
+
+        // Concatenated members read as one file, long enough to be handed to the parser in several blocks.
+        std::ifstream file(compressed_path, std::ios::binary);
+        std::string member((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto path = std::filesystem::temp_directory_path() /
+                    ("poly_io_test_concatenated" + std::filesystem::path(compressed_path).extension().string());
+        constexpr size_t kRepeats = 64;
+        {
+            std::ofstream concatenated(path, std::ios::binary);
+            for (size_t i = 0; i < kRepeats; ++i) {
+                concatenated << member;
+            }
+        }
+        auto plain = reader_->ParsePointsAndPolygonsFromFile(polygons_file_path_, ErrorPolicy::kCollect);
+        auto result = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kCollect);
+        EXPECT_EQ(kRepeats * expected.size(), result.point_and_polygons.size());
+        ASSERT_EQ(kRepeats * plain.diagnostics.size(), result.diagnostics.size());
+        size_t text_size = std::filesystem::file_size(polygons_file_path_);
+        for (size_t i = 0; i < result.diagnostics.size(); ++i) {
+            const auto& diagnostic = plain.diagnostics[i % plain.diagnostics.size()];
+            size_t repeat = i / plain.diagnostics.size();
+            EXPECT_EQ(diagnostic.byte_offset + repeat * text_size, result.diagnostics[i].byte_offset);
+            EXPECT_EQ(diagnostic.kind, result.diagnostics[i].kind);
+        }
+        auto visit_all = [](float, float, Polygon&) { return true; };
+        auto visit_first = [](float, float, Polygon&) { return false; };
+        EXPECT_EQ(kRepeats * expected.size(), reader_->ForEachPointAndPolygonInFile(path.string(), visit_all));
+        size_t count = reader_->ForEachPointAndPolygonInFile(path.string(), visit_first);
+        EXPECT_EQ(1u, count);
+
+        // Truncated input fails like any other unreadable file.
+        std::ofstream(path, std::ios::binary) << member.substr(0, member.size() / 2);
+        EXPECT_THROW(reader_->ReadPointsAndPolygonsFromFile(path.string()), std::runtime_error);
+        std::filesystem::remove(path);
+    }
+#endif
+
     std::unique_ptr<IPolygonReader> reader_;
     const std::string polygons_file_path_;
     const std::string polygons_crlf_file_path_;
@@ -77,6 +154,28 @@ TEST_F(PolygonTest, MixedNotationTolerant) {
     EXPECT_FLOAT_EQ(5.f, std::get<1>(point_and_polygon));
 }
 
+TEST_F(PolygonTest, ParsesNumbersLikeStof) {
+    std::string polygon_string = "+4 -5e0 0x1p-1 0.0\t1.5f -0.5 .5 1.25\r 0x1p-1 0.0";
+    auto [x, y, polygon] = reader_->CreatePointAndPolygonFromString(polygon_string);
+    EXPECT_FLOAT_EQ(4.f, x);
+    EXPECT_FLOAT_EQ(-5.f, y);
+    ASSERT_EQ(4u, polygon.size());
+    EXPECT_FLOAT_EQ(0.5f, polygon.x_vec_[0]);
+    EXPECT_FLOAT_EQ(1.5f, polygon.x_vec_[1]);
+    EXPECT_FLOAT_EQ(-0.5f, polygon.y_vec_[1]);
+    EXPECT_FLOAT_EQ(1.25f, polygon.y_vec_[2]);
+
+    for (std::string bad : {"+-1", "--1", "f1", "+", "-"}) {
+        EXPECT_THROW(reader_->CreatePointAndPolygonFromString("0 0 0 0 1 0 " + bad + " 1"), std::runtime_error) << bad;
+    }
+    try {
+        reader_->CreatePointAndPolygonFromString("0 0 0 0 1e50 0 1 1");
+        FAIL() << "1e50 does not fit in a float";
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(std::string("Could not parse line because this is too large to fit in a float: 1e50"), e.what());
+    }
+}
+
 TEST_F(PolygonTest, CanReadPolygonsFromFile) {
     auto polygons = reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_);
     EXPECT_FALSE(polygons.empty());
@@ -91,4 +190,311 @@ TEST_F(PolygonTest, CanCopeWithCRLF) {
     EXPECT_EQ(30, polygons.size());
 }
 
+TEST_F(PolygonTest, CRLFFileMatchesLFFile) {
+    auto polygons = reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_);
+    auto crlf_polygons = reader_->ReadPointsAndPolygonsFromFile(polygons_crlf_file_path_);
+    ASSERT_EQ(polygons.size(), crlf_polygons.size());
+    for (size_t i = 0; i < polygons.size(); ++i) {
+        EXPECT_EQ(std::get<0>(polygons[i]), std::get<0>(crlf_polygons[i]));
+        EXPECT_EQ(std::get<1>(polygons[i]), std::get<1>(crlf_polygons[i]));
+        EXPECT_EQ(std::get<2>(polygons[i]).x_vec_, std::get<2>(crlf_polygons[i]).x_vec_);
+        EXPECT_EQ(std::get<2>(polygons[i]).y_vec_, std::get<2>(crlf_polygons[i]).y_vec_);
+    }
+}
+
+TEST_F(PolygonTest, ReadsLineEndingsAndCommentsFromFile) {
+    auto path = std::filesystem::temp_directory_path() / "poly_io_test_line_endings.txt";
+    auto read = [&](const std::string& contents) {
+        std::ofstream(path, std::ios::binary) << contents;
+        return reader_->ReadPointsAndPolygonsFromFile(path.string());
+    };
+    const std::string line = "0.5 0.5 0 0 1 0 1 1 0 0";
+    EXPECT_EQ(0u, read("").size());
+    EXPECT_EQ(1u, read(line).size());
+    EXPECT_EQ(1u, read(line + "\n").size());
+    EXPECT_EQ(2u, read(line + "\r\n\r\n" + line + "\r\n").size());
+    EXPECT_EQ(2u, read("# header\n" + line + " # trailing comment\n\n" + line).size());
+    EXPECT_EQ(1u, read(line + "\nnot a polygon\n").size());
+    std::filesystem::remove(path);
+}
+
+TEST_F(PolygonTest, ParallelReadMatchesSequentialRead) {
+    // Large enough to be split between threads, with unparsable lines scattered through it.
+    auto path = std::filesystem::temp_directory_path() / "poly_io_test_parallel.txt";
+    std::vector<size_t> bad_lines;
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (size_t line = 1; line <= 20000; ++line) {
+            if (line % 997 == 0) {
+                file << "0 0 0 0 1 0 not_a_float 1\r\n";
+                bad_lines.push_back(line);
+            } else {
+                file << line << " 0.5 0 0 1 0 1 1 0 1 0 0 # line " << line << "\r\n";
+            }
+        }
+    }
+    auto sequential = reader_->ReadPointsAndPolygonsFromFile(path.string());
+    for (size_t thread_count : {0, 1, 2, 7, 32}) {
+        std::vector<LineError> line_errors;
+        auto parallel = reader_->ReadPointsAndPolygonsFromFile(path.string(), thread_count, &line_errors);
+        ASSERT_EQ(sequential.size(), parallel.size()) << thread_count << " threads";
+        for (size_t i = 0; i < sequential.size(); ++i) {
+            EXPECT_EQ(std::get<0>(sequential[i]), std::get<0>(parallel[i]));
+            EXPECT_EQ(std::get<2>(sequential[i]).x_vec_, std::get<2>(parallel[i]).x_vec_);
+        }
+        ASSERT_EQ(bad_lines.size(), line_errors.size()) << thread_count << " threads";
+        for (size_t i = 0; i < bad_lines.size(); ++i) {
+            EXPECT_EQ(bad_lines[i], line_errors[i].line);
+            EXPECT_NE(std::string::npos, line_errors[i].message.find("not_a_float"));
+        }
+    }
+    EXPECT_EQ(20000 - bad_lines.size(), sequential.size());
+    std::filesystem::remove(path);
+}
+
+TEST_F(PolygonTest, StreamsRecordsInFileOrder) {
+    auto expected = reader_->ReadPointsAndPolygonsFromFile(polygons_crlf_file_path_);
+    size_t index = 0;
+    auto visitor = [&](float x, float y, Polygon& polygon) {
+        EXPECT_EQ(std::get<0>(expected[index]), x);
+        EXPECT_EQ(std::get<1>(expected[index]), y);
+        EXPECT_EQ(std::get<2>(expected[index]).x_vec_, polygon.x_vec_);
+        EXPECT_EQ(std::get<2>(expected[index]).y_vec_, polygon.y_vec_);
+        ++index;
+        return true;
+    };
+    size_t count = reader_->ForEachPointAndPolygonInFile(polygons_crlf_file_path_, visitor);
+    EXPECT_EQ(expected.size(), count);
+    EXPECT_EQ(expected.size(), index);
+
+    // Stopping early, and reporting the lines that were skipped.
+    auto path = std::filesystem::temp_directory_path() / "poly_io_test_streaming.txt";
+    std::ofstream(path, std::ios::binary) << "0 0 0 0 1 0 1 1\nbad\n\n1 1 0 0 1 0 1 1\n2 2 0 0 1 0 1 1\n";
+    std::vector<LineError> line_errors;
+    std::vector<float> xs;
+    count = reader_->ForEachPointAndPolygonInFile(
+            path.string(),
+            [&](float x, float, Polygon&) {
+                xs.push_back(x);
+                return xs.size() < 2;
+            },
+            &line_errors);
+    EXPECT_EQ(2u, count);
+    EXPECT_EQ(std::vector<float>({0.f, 1.f}), xs);
+    // The blank line is skipped without an error.
+    ASSERT_EQ(1u, line_errors.size());
+    EXPECT_EQ(2u, line_errors[0].line);
+    std::filesystem::remove(path);
+}
+
+TEST_F(PolygonTest, ReportsParseErrorsByPolicy) {
+    auto path = std::filesystem::temp_directory_path() / "poly_io_test_policy.txt";
+    std::string text = "0 0 0 0 1 0 1 1\n"  // line 1, offset 0
+                       "1 1 0 0 1e99 0\n"   // line 2, offset 16
+                       "2 2 0 0 1 0 1 1\n"  // line 3, offset 31
+                       "3\n"                // line 4, offset 47
+                       "4 4 0 0 x\n";       // line 5, offset 49
+    std::ofstream(path, std::ios::binary) << text;
+
+    auto skipped = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kSkip);
+    EXPECT_EQ(2u, skipped.point_and_polygons.size());
+    EXPECT_TRUE(skipped.diagnostics.empty());
+    EXPECT_FALSE(skipped.stopped);
+
+    auto collected = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kCollect);
+    EXPECT_EQ(2u, collected.point_and_polygons.size());
+    EXPECT_FALSE(collected.stopped);
+    ASSERT_EQ(3u, collected.diagnostics.size());
+    EXPECT_EQ(2u, collected.diagnostics[0].line);
+    EXPECT_EQ(text.find("1e99"), collected.diagnostics[0].byte_offset);
+    EXPECT_EQ(ParseErrorKind::kOutOfRange, collected.diagnostics[0].kind);
+    EXPECT_EQ(4u, collected.diagnostics[1].line);
+    EXPECT_EQ(47u, collected.diagnostics[1].byte_offset);
+    EXPECT_EQ(ParseErrorKind::kMissingPointY, collected.diagnostics[1].kind);
+    EXPECT_EQ(5u, collected.diagnostics[2].line);
+    EXPECT_EQ(text.find('x'), collected.diagnostics[2].byte_offset);
+    EXPECT_EQ(ParseErrorKind::kNotAFloat, collected.diagnostics[2].kind);
+
+    auto stopped = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kStop);
+    EXPECT_EQ(1u, stopped.point_and_polygons.size());
+    EXPECT_TRUE(stopped.stopped);
+    ASSERT_EQ(1u, stopped.diagnostics.size());
+    EXPECT_EQ(2u, stopped.diagnostics[0].line);
+
+    EXPECT_THROW(reader_->ParsePointsAndPolygonsFromFile("does_not_exist.txt", ErrorPolicy::kSkip),
+                 std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+#if defined(__linux__)
+TEST_F(PolygonTest, ReadsFilesThatReportNoSize) {
+    // Files on procfs report a size of 0 but still have contents, none of which parses as polygons.
+    auto result = reader_->ParsePointsAndPolygonsFromFile("/proc/self/status", ErrorPolicy::kCollect);
+    EXPECT_TRUE(result.point_and_polygons.empty());
+    EXPECT_FALSE(result.diagnostics.empty());
+}
+#endif
+
+TEST_F(PolygonTest, SkipsCommentLinesUnderEveryPolicy) {
+    // polygons.txt has a comment line before every record.
+    for (ErrorPolicy policy : {ErrorPolicy::kSkip, ErrorPolicy::kStop, ErrorPolicy::kCollect}) {
+        auto result = reader_->ParsePointsAndPolygonsFromFile(polygons_file_path_, policy);
+        EXPECT_EQ(30u, result.point_and_polygons.size());
+        EXPECT_TRUE(result.diagnostics.empty());
+        EXPECT_FALSE(result.stopped);
+    }
+    std::vector<LineError> line_errors;
+    EXPECT_EQ(30u, reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_, 1, &line_errors).size());
+    EXPECT_EQ(30u, reader_->ForEachPointAndPolygonInFile(
+                           polygons_file_path_, [](float, float, Polygon&) { return true; }, &line_errors));
+    EXPECT_TRUE(line_errors.empty());
+    EXPECT_THROW(reader_->CreatePointAndPolygonFromString("# only a comment"), std::runtime_error);
+}
+
+TEST_F(PolygonTest, ParallelParseMatchesSequentialParse) {
+    // Large enough to be split between threads, so that diagnostics are numbered across range boundaries.
+    auto path = std::filesystem::temp_directory_path() / "poly_io_test_parallel_parse.txt";
+    std::string text;
+    std::vector<size_t> bad_line_offsets;
+    for (size_t line = 1; line <= 20000; ++line) {
+        if (line % 997 == 0) {
+            bad_line_offsets.push_back(text.size());
+            text += "0 0 0 0\n";
+        } else {
+            text += std::to_string(line) + " 0.5 0 0 1 0 1 1 0 1 0 0\n";
+        }
+    }
+    std::ofstream(path, std::ios::binary) << text;
+
+    auto sequential = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kCollect);
+    ASSERT_EQ(bad_line_offsets.size(), sequential.diagnostics.size());
+    for (size_t i = 0; i < bad_line_offsets.size(); ++i) {
+        EXPECT_EQ(997 * (i + 1), sequential.diagnostics[i].line);
+        EXPECT_EQ(bad_line_offsets[i], sequential.diagnostics[i].byte_offset);
+        EXPECT_EQ(ParseErrorKind::kInsufficientGeometry, sequential.diagnostics[i].kind);
+    }
+    for (ErrorPolicy policy : {ErrorPolicy::kCollect, ErrorPolicy::kStop}) {
+        auto expected = reader_->ParsePointsAndPolygonsFromFile(path.string(), policy);
+        for (size_t thread_count : {0, 2, 7, 32}) {
+            auto parallel = reader_->ParsePointsAndPolygonsFromFile(path.string(), policy, thread_count);
+            ASSERT_EQ(expected.point_and_polygons.size(), parallel.point_and_polygons.size());
+            EXPECT_EQ(expected.stopped, parallel.stopped);
+            ASSERT_EQ(expected.diagnostics.size(), parallel.diagnostics.size()) << thread_count << " threads";
+            for (size_t i = 0; i < expected.diagnostics.size(); ++i) {
+                EXPECT_EQ(expected.diagnostics[i].line, parallel.diagnostics[i].line);
+                EXPECT_EQ(expected.diagnostics[i].byte_offset, parallel.diagnostics[i].byte_offset);
+            }
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_F(PolygonTest, SkipsLinesOverTheLengthLimit) {
+    std::string long_line = "1 1";
+    while (long_line.size() < (size_t(1) << 20)) {
+        long_line += " 0.5 0 0 1 1 0";
+    }
+    std::string text = "0 0 0 0 1 0 1 1\n" +  // line 1, offset 0
+                       long_line + "\n" +       // line 2, offset 16
+                       "2 2 0 0 1 0 1 1\n"      // line 3
+                       "x\n"                    // line 4
+                       "3 3 0 0 1 0 1 1";       // line 5, without a newline
+    std::vector<std::filesystem::path> paths = {std::filesystem::temp_directory_path() / "poly_io_test_long_line.txt"};
+    std::ofstream(paths.back(), std::ios::binary) << text;
+#if defined(WINDING_NUMBER_HAVE_ZLIB)
+    // Longer than a decompressed block, so that the compressed read cuts the line instead of holding it whole.
+    paths.push_back(std::filesystem::temp_directory_path() / "poly_io_test_long_line.txt.gz");
+    std::ofstream(paths.back(), std::ios::binary) << Gzip(text);
+#endif
+
+    for (const auto& path : paths) {
+        // Within the limit, or without one, the long line is a record like any other.
+        for (size_t limit : {size_t(0), long_line.size()}) {
+            reader_->max_line_bytes(limit);
+            auto result = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kCollect);
+            EXPECT_EQ(4u, result.point_and_polygons.size()) << path;
+            ASSERT_EQ(1u, result.diagnostics.size()) << path;
+            EXPECT_EQ(4u, result.diagnostics[0].line);
+        }
+        for (size_t limit : {size_t(1000), long_line.size() - 1}) {
+            reader_->max_line_bytes(limit);
+            auto result = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kCollect);
+            ASSERT_EQ(3u, result.point_and_polygons.size()) << path << " limit " << limit;
+            EXPECT_EQ(2.f, std::get<0>(result.point_and_polygons[1]));
+            ASSERT_EQ(2u, result.diagnostics.size());
+            EXPECT_EQ(2u, result.diagnostics[0].line);
+            EXPECT_EQ(16u, result.diagnostics[0].byte_offset);
+            EXPECT_EQ(ParseErrorKind::kLineTooLong, result.diagnostics[0].kind);
+            EXPECT_EQ(4u, result.diagnostics[1].line);
+            EXPECT_EQ(text.find("x\n"), result.diagnostics[1].byte_offset);
+
+            std::vector<LineError> line_errors;
+            size_t count = reader_->ForEachPointAndPolygonInFile(
+                    path.string(), [](float, float, Polygon&) { return true; }, &line_errors);
+            EXPECT_EQ(3u, count);
+            ASSERT_EQ(2u, line_errors.size());
+            EXPECT_EQ(2u, line_errors[0].line);
+            EXPECT_EQ(4u, line_errors[1].line);
+        }
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_F(PolygonTest, FileTokenizerMatchesLineTokenizer) {
+    // Lines of varied lengths, so that tokens, comments and line ends fall on every offset of the scanner's blocks.
+    auto path = std::filesystem::temp_directory_path() / "poly_io_test_tokenizer.txt";
+    const char* pieces[] = {" ", "\t", "  ", "1", "-2.5", "0x1p3", "3.f", "#", "# 4 5", "x", "\r", "1e99", "7"};
+    std::mt19937 random(49);
+    std::vector<std::string> lines;
+    std::string text;
+    for (size_t line = 0; line < 2000; ++line) {
+        std::string contents;
+        for (size_t i = random() % 40; i > 0; --i) {
+            contents += pieces[random() % std::size(pieces)];
+            contents += random() % 3 ? " " : "";
+        }
+        lines.push_back(contents);
+        text += contents + "\n";
+    }
+    text += "0 0 0 0 1 0 1 1 # no final newline";
+    lines.push_back("0 0 0 0 1 0 1 1 # no final newline");
+    std::ofstream(path, std::ios::binary) << text;
+
+    auto result = reader_->ParsePointsAndPolygonsFromFile(path.string(), ErrorPolicy::kCollect);
+    size_t record = 0;
+    size_t diagnostic = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        try {
+            auto expected = reader_->CreatePointAndPolygonFromString(lines[i]);
+            ASSERT_LT(record, result.point_and_polygons.size());
+            const auto& actual = result.point_and_polygons[record++];
+            EXPECT_EQ(std::get<0>(expected), std::get<0>(actual)) << "line " << i + 1;
+            EXPECT_EQ(std::get<1>(expected), std::get<1>(actual)) << "line " << i + 1;
+            EXPECT_EQ(std::get<2>(expected).x_vec_, std::get<2>(actual).x_vec_) << "line " << i + 1;
+            EXPECT_EQ(std::get<2>(expected).y_vec_, std::get<2>(actual).y_vec_) << "line " << i + 1;
+        } catch (const std::runtime_error&) {
+            // Files skip lines without tokens, which only the single line parser rejects.
+            std::string_view body = std::string_view(lines[i]).substr(0, lines[i].find('#'));
+            if (body.find_first_not_of(" \t") == std::string_view::npos) continue;
+            ASSERT_LT(diagnostic, result.diagnostics.size());
+            EXPECT_EQ(i + 1, result.diagnostics[diagnostic++].line);
+        }
+    }
+    EXPECT_EQ(result.point_and_polygons.size(), record);
+    EXPECT_EQ(result.diagnostics.size(), diagnostic);
+    std::filesystem::remove(path);
+}
+
+#if defined(WINDING_NUMBER_HAVE_ZLIB)
+TEST_F(PolygonTest, ReadsGzipCompressedFiles) {
+    ExpectReadsCompressedFile(polygons_file_path_ + ".gz");
+}
+#endif
+
+#if defined(WINDING_NUMBER_HAVE_ZSTD)
+TEST_F(PolygonTest, ReadsZstdCompressedFiles) {
+    ExpectReadsCompressedFile(polygons_file_path_ + ".zst");
+}
+#endif
+
 }  // namespace poly
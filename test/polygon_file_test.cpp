@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <polygon_file.hpp>
+#include <polygon_layout.hpp>
+
+namespace poly {
+
+class PolygonFileTest : public ::testing::Test {
+protected:
+    PolygonFileTest() :
+            reader_(IPolygonReader::Create()),
+            polygons_crlf_file_path_((std::filesystem::current_path() / "crlf_polygons.txt").string()),
+            binary_path_((std::filesystem::temp_directory_path() / "polygon_file_test.bin").string()) {}
+
+    ~PolygonFileTest() override {
+        std::filesystem::remove(binary_path_);
+    }
+
+    std::unique_ptr<IPolygonReader> reader_;
+    const std::string polygons_crlf_file_path_;
+    const std::string binary_path_;
+};
+
+TEST_F(PolygonFileTest, RoundTripsTextFile) {
+    auto expected = reader_->ReadPointsAndPolygonsFromFile(polygons_crlf_file_path_);
+    EXPECT_EQ(expected.size(), WritePolygonFile(*reader_, polygons_crlf_file_path_, binary_path_));
+
+    PolygonFile file(binary_path_);
+    file.Validate();
+    ASSERT_EQ(expected.size(), file.size());
+    for (size_t i = 0; i < file.size(); ++i) {
+        const auto& [x, y, polygon] = expected[i];
+        EXPECT_EQ(x, file.point_x(i));
+        EXPECT_EQ(y, file.point_y(i));
+        PolygonView view = file.polygon(i);
+        ASSERT_EQ(polygon.size(), view.size());
+        EXPECT_EQ(polygon.x_vec_, ToPolygon(view).x_vec_);
+        EXPECT_EQ(polygon.y_vec_, ToPolygon(view).y_vec_);
+    }
+
+    // Views point into the mapping, consecutive records are adjacent in the vertex columns.
+    ASSERT_GE(file.size(), 2u);
+    EXPECT_EQ(file.polygon(0).x_data() + file.polygon(0).size(), file.polygon(1).x_data());
+}
+
+TEST_F(PolygonFileTest, WritesRecordsDirectly) {
+    Polygon triangle;
+    triangle.AppendPoint(0.f, 0.f);
+    triangle.AppendPoint(1.f, 0.f);
+    triangle.AppendPoint(0.f, 1.f);
+    triangle.ClosePolygon();
+    WritePolygonFile({{0.25f, 0.25f, triangle}, {2.f, 3.f, triangle}}, binary_path_);
+    PolygonFile file(binary_path_);
+    ASSERT_EQ(2u, file.size());
+    EXPECT_EQ(3.f, file.point_y_data()[1]);
+    EXPECT_EQ(4u, file.vertex_offsets()[1]);
+    EXPECT_EQ(1.f, file.polygon(1).y(2));
+
+    WritePolygonFile({}, binary_path_);
+    EXPECT_EQ(0u, PolygonFile(binary_path_).size());
+}
+
+TEST_F(PolygonFileTest, RejectsInvalidFiles) {
+    EXPECT_THROW(PolygonFile file(polygons_crlf_file_path_), std::runtime_error);
+
+    Polygon triangle;
+    triangle.AppendPoint(0.f, 0.f);
+    triangle.AppendPoint(1.f, 0.f);
+    triangle.AppendPoint(0.f, 1.f);
+    triangle.ClosePolygon();
+    WritePolygonFile({{0.25f, 0.25f, triangle}}, binary_path_);
+    auto size = std::filesystem::file_size(binary_path_);
+    std::filesystem::resize_file(binary_path_, size - 4);
+    EXPECT_THROW(PolygonFile file(binary_path_), std::runtime_error);
+
+    // Stray bytes after the last column, fewer than a vertex's worth.
+    for (size_t extra = 1; extra < 8; ++extra) {
+        std::filesystem::resize_file(binary_path_, size + extra);
+        EXPECT_THROW(PolygonFile file(binary_path_), std::runtime_error) << extra << " trailing bytes";
+    }
+    std::filesystem::resize_file(binary_path_, size);
+    EXPECT_NO_THROW(PolygonFile file(binary_path_));
+
+    // A corrupt offsets table is caught by Validate().
+    WritePolygonFile({{0.25f, 0.25f, triangle}, {0.25f, 0.25f, triangle}}, binary_path_);
+    {
+        std::fstream fs(binary_path_, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t offset = 100;
+        fs.seekp(sizeof(PolygonFileHeader) + sizeof(uint64_t));
+        fs.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    PolygonFile corrupt(binary_path_);
+    EXPECT_THROW(corrupt.Validate(), std::runtime_error);
+}
+
+}  // namespace poly
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <polygon_layout.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+namespace poly {
+
+class PolygonLayoutTest : public ::testing::Test {
+protected:
+    // A 21-vertex star, more vertices than fit in one block of any of the layouts.
+    static Polygon MakeStar() {
+        Polygon p;
+        for (int i = 0; i < 20; ++i) {
+            float angle = 2.f * float(M_PI) * float(i) / 20.f;
+            float radius = i % 2 ? 1.f : 2.f;
+            p.AppendPoint(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        p.ClosePolygon();
+        return p;
+    }
+
+    static constexpr VertexLayout kLayouts[] = {VertexLayout::kSeparate, VertexLayout::kInterleaved,
+                                                VertexLayout::kBlocked8, VertexLayout::kBlocked16};
+};
+
+TEST_F(PolygonLayoutTest, PlacesCoordinates) {
+    EXPECT_EQ(6u, InterleavedLayout::XIndex(3));
+    EXPECT_EQ(7u, InterleavedLayout::YIndex(3));
+    EXPECT_EQ(2u, Blocked8Layout::XIndex(2));
+    EXPECT_EQ(10u, Blocked8Layout::YIndex(2));
+    EXPECT_EQ(17u, Blocked8Layout::XIndex(9));
+    EXPECT_EQ(25u, Blocked8Layout::YIndex(9));
+    EXPECT_EQ(32u, Blocked8Layout::ArraySize(9));
+    EXPECT_EQ(32u, Blocked16Layout::ArraySize(16));
+
+    // Views wrap existing memory without copying it.
+    Polygon star = MakeStar();
+    PolygonView view = MakeView(star);
+    EXPECT_EQ(star.x_vec_.data(), view.x_data());
+    EXPECT_EQ(star.size(), view.size());
+
+    std::vector<float> interleaved = {0.f, 1.f, 2.f, 3.f};
+    BasicPolygonView<InterleavedLayout> pairs(interleaved.data(), 2);
+    EXPECT_EQ(2.f, pairs.x(1));
+    EXPECT_EQ(3.f, pairs.y(1));
+}
+
+TEST_F(PolygonLayoutTest, VertexBuffersRoundTrip) {
+    Polygon star = MakeStar();
+    for (VertexLayout layout : kLayouts) {
+        VertexBuffer buffer(star, layout);
+        EXPECT_EQ(layout, buffer.layout());
+        EXPECT_EQ(star.size(), buffer.size());
+        Polygon copy = buffer.ToPolygon();
+        EXPECT_EQ(star.x_vec_, copy.x_vec_);
+        EXPECT_EQ(star.y_vec_, copy.y_vec_);
+    }
+
+    // Moving a polygon into the separate layout keeps its arrays.
+    Polygon moved = MakeStar();
+    const float* data = moved.x_vec_.data();
+    VertexBuffer buffer(std::move(moved), VertexLayout::kSeparate);
+    EXPECT_EQ(data, buffer.Visit([](const auto& view) { return view.x_data(); }));
+}
+
+TEST_F(PolygonLayoutTest, EnginesAgreeAcrossLayouts) {
+    auto algorithm = winding_number::IWindingNumberAlgorithm::Create();
+    algorithm->tolerance(1e-6f);
+    Polygon star = MakeStar();
+    auto reference = algorithm->Prepare(star, winding_number::Engine::kScan);
+    ASSERT_TRUE(reference);
+
+    std::vector<float> xs, ys;
+    for (float x = -2.5f; x <= 2.5f; x += 0.125f) {
+        for (float y = -2.5f; y <= 2.5f; y += 0.125f) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+    for (size_t i = 0; i < star.size(); ++i) {
+        xs.push_back(star.x_vec_[i]);
+        ys.push_back(star.y_vec_[i]);
+    }
+    for (VertexLayout layout : kLayouts) {
+        algorithm->vertex_layout(layout);
+        for (auto engine : {winding_number::Engine::kScan, winding_number::Engine::kPointBatch,
+                            winding_number::Engine::kHullFilter}) {
+            auto prepared = algorithm->Prepare(star, engine);
+            ASSERT_TRUE(prepared);
+            std::vector<int> batch(xs.size());
+            prepared->CalculateWindingNumbers2D(xs.data(), ys.data(), xs.size(), batch.data());
+            for (size_t i = 0; i < xs.size(); ++i) {
+                int expected = reference->CalculateWindingNumber2D(xs[i], ys[i]);
+                EXPECT_EQ(expected, prepared->CalculateWindingNumber2D(xs[i], ys[i]));
+                EXPECT_EQ(expected, batch[i]) << "layout " << int(layout) << " at (" << xs[i] << ", " << ys[i] << ")";
+            }
+        }
+    }
+}
+
+}  // namespace poly
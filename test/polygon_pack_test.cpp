@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <polygon_pack.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class PolygonPackTest : public ::testing::Test {
+protected:
+    PolygonPackTest() : algorithm_(IWindingNumberAlgorithm::Create()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    // Small random polygons around a common center, of between 3 and 12 vertices, some of them self-intersecting.
+    static poly::PolygonSet MakeRandomSet(std::mt19937& generator, size_t count) {
+        std::uniform_real_distribution<float> coordinate(-2.f, 2.f);
+        std::uniform_int_distribution<int> vertex_count(3, 12);
+        poly::PolygonSet set;
+        for (size_t i = 0; i < count; ++i) {
+            Polygon p;
+            for (int j = vertex_count(generator); j > 0; --j) {
+                p.AppendPoint(coordinate(generator), coordinate(generator));
+            }
+            p.ClosePolygon();
+            set.AppendPolygon(std::move(p));
+        }
+        return set;
+    }
+
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+};
+
+TEST_F(PolygonPackTest, MatchesScanOfEveryCandidate) {
+    std::mt19937 generator(41);
+    poly::PolygonSet set = MakeRandomSet(generator, 30);
+    std::vector<std::unique_ptr<IPreparedPolygon>> scans;
+    for (const auto& polygon : set.polygons_) {
+        scans.push_back(algorithm_->Prepare(polygon, Engine::kScan));
+        ASSERT_TRUE(scans.back());
+    }
+
+    // Candidate lists out of order, with repeats, and of sizes around a multiple of the lane count.
+    std::uniform_int_distribution<size_t> polygon(0, set.size() - 1);
+    for (size_t count : {size_t(1), size_t(7), size_t(8), size_t(9), size_t(23)}) {
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < count; ++i) {
+            candidates.push_back(polygon(generator));
+        }
+        auto pack = PolygonPack::Build(set, candidates, *algorithm_);
+        ASSERT_TRUE(pack);
+        EXPECT_EQ(count, pack->size());
+        for (float x = -2.5f; x <= 2.5f; x += 0.125f) {
+            for (float y = -2.5f; y <= 2.5f; y += 0.125f) {
+                auto winding_numbers = pack->CalculateWindingNumbers2D(x, y);
+                ASSERT_EQ(count, winding_numbers.size());
+                for (size_t i = 0; i < count; ++i) {
+                    EXPECT_EQ(scans[candidates[i]]->CalculateWindingNumber2D(x, y), winding_numbers[i])
+                            << "polygon " << candidates[i] << " at (" << x << ", " << y << ")";
+                }
+            }
+        }
+        // Vertices sit on two edges of their polygon at once.
+        for (size_t i = 0; i < count; ++i) {
+            const Polygon& p = set.polygons_[candidates[i]];
+            for (size_t v = 0; v < p.size(); ++v) {
+                EXPECT_EQ(scans[candidates[i]]->CalculateWindingNumber2D(p.x_vec_[v], p.y_vec_[v]),
+                          pack->CalculateWindingNumbers2D(p.x_vec_[v], p.y_vec_[v])[i]);
+            }
+        }
+    }
+}
+
+TEST_F(PolygonPackTest, SortsCandidatesBySizeToLimitPadding) {
+    poly::PolygonSet set;
+    std::vector<size_t> candidates;
+    // Alternating triangles and 40-gons: dealt out in list order, every group would be padded to 40 vertices.
+    for (size_t i = 0; i < 16; ++i) {
+        Polygon p;
+        size_t vertex_count = i % 2 ? 40 : 3;
+        for (size_t j = 0; j < vertex_count; ++j) {
+            float angle = 6.2831853f * float(j) / float(vertex_count);
+            p.AppendPoint(std::cos(angle), std::sin(angle));
+        }
+        p.ClosePolygon();
+        set.AppendPolygon(std::move(p));
+        candidates.push_back(i);
+    }
+    auto pack = PolygonPack::Build(set, candidates, *algorithm_);
+    ASSERT_TRUE(pack);
+    EXPECT_FLOAT_EQ(0.f, pack->padding_fraction());
+
+    auto winding_numbers = pack->CalculateWindingNumbers2D(0.f, 0.f);
+    for (int winding_number : winding_numbers) {
+        EXPECT_EQ(1, winding_number);
+    }
+}
+
+TEST_F(PolygonPackTest, FailsOnUnclosedCandidates) {
+    poly::PolygonSet set;
+    Polygon unclosed;
+    unclosed.AppendPoint(0.f, 0.f);
+    unclosed.AppendPoint(1.f, 0.f);
+    unclosed.AppendPoint(1.f, 1.f);
+    set.AppendPolygon(unclosed);
+    EXPECT_FALSE(PolygonPack::Build(set, {0}, *algorithm_));
+    EXPECT_FALSE(algorithm_->error_message().empty());
+
+    auto empty = PolygonPack::Build(set, {}, *algorithm_);
+    ASSERT_TRUE(empty);
+    EXPECT_EQ(0u, empty->size());
+    EXPECT_TRUE(empty->CalculateWindingNumbers2D(0.f, 0.f).empty());
+}
+
+}  // namespace winding_number
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class PreparedPolygonTest : public ::testing::Test {
+protected:
+    PreparedPolygonTest() :
+            reader_(poly::IPolygonReader::Create()),
+            algorithm_(IWindingNumberAlgorithm::Create()),
+            polygons_file_path_((std::filesystem::current_path() / "polygons.txt").string()),
+            tolerance_(1e-6f) {
+        algorithm_->tolerance(tolerance_);
+    }
+
+    // Checks the prepared polygon against the simple algorithm on a grid of points that avoids every vertex and
+    // axis-aligned edge of the test polygons.
+    void ExpectMatchesSimpleOnGrid(const Polygon& polygon, const IPreparedPolygon& prepared) {
+        for (float x = -2.13f; x < 5.f; x += 0.25f) {
+            for (float y = -2.07f; y < 5.f; y += 0.25f) {
+                auto expected = algorithm_->CalculateWindingNumber2D(x, y, polygon);
+                ASSERT_TRUE(expected);
+                EXPECT_EQ(*expected, prepared.CalculateWindingNumber2D(x, y)) << "at (" << x << ", " << y << ")";
+            }
+        }
+    }
+
+    std::unique_ptr<poly::IPolygonReader> reader_;
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+    const std::string polygons_file_path_;
+    const float tolerance_;
+};
+
+TEST_F(PreparedPolygonTest, NormalizeCollapsesDuplicateVertices) {
+    Polygon p;
+    p.AppendPoint(0.0, 0.0);
+    p.AppendPoint(1.0, 0.0);
+    p.AppendPoint(1.0, 1e-7f);
+    p.AppendPoint(1.0, 1.0);
+    p.AppendPoint(1.0, 1.0);
+    p.AppendPoint(0.0, 1.0);
+    p.AppendPoint(1e-7f, 0.0);
+    p.AppendPoint(0.0, 0.0);
+
+    auto normalized = algorithm_->Normalize(p);
+    ASSERT_TRUE(normalized);
+    EXPECT_EQ(5u, normalized->polygon.size());
+    EXPECT_TRUE(normalized->polygon.IsClosed());
+    EXPECT_EQ(8u, normalized->input_vertex_count);
+    EXPECT_EQ(3u, normalized->duplicate_vertices_removed);
+    EXPECT_EQ(0u, normalized->collinear_vertices_removed);
+    EXPECT_FLOAT_EQ(3.f / 8.f, normalized->vertex_reduction());
+}
+
+TEST_F(PreparedPolygonTest, NormalizeMergesCollinearRuns) {
+    Polygon p;
+    p.AppendPoint(0.0, 0.0);
+    p.AppendPoint(1.0, 0.0);
+    p.AppendPoint(2.0, 0.0);
+    p.AppendPoint(3.0, 0.0);
+    p.AppendPoint(3.0, 3.0);
+    p.AppendPoint(2.0, 2.0);
+    p.AppendPoint(1.0, 1.0);
+    p.AppendPoint(0.0, 0.0);
+
+    auto normalized = algorithm_->Normalize(p);
+    ASSERT_TRUE(normalized);
+    EXPECT_EQ(4u, normalized->polygon.size());
+    EXPECT_EQ(4u, normalized->collinear_vertices_removed);
+    ExpectMatchesSimpleOnGrid(p, *algorithm_->Prepare(p, Engine::kScan));
+}
+
+TEST_F(PreparedPolygonTest, NormalizeKeepsVerticalRuns) {
+    Polygon p;
+    p.AppendPoint(0.0, 0.0);
+    p.AppendPoint(1.0, 0.0);
+    p.AppendPoint(1.0, 1.0);
+    p.AppendPoint(1.0, 2.0);
+    p.AppendPoint(0.0, 2.0);
+    p.AppendPoint(0.0, 0.0);
+
+    auto normalized = algorithm_->Normalize(p);
+    ASSERT_TRUE(normalized);
+    EXPECT_EQ(6u, normalized->polygon.size());
+
+    // Sitting on the shared vertex of two upward edges is counted once per edge by the simple algorithm.
+    auto prepared = algorithm_->Prepare(p);
+    EXPECT_EQ(*algorithm_->CalculateWindingNumber2D(1.0, 1.0, p), prepared->CalculateWindingNumber2D(1.0, 1.0));
+}
+
+TEST_F(PreparedPolygonTest, NormalizeFailsOnUnclosedOrCollapsedPolygons) {
+    Polygon unclosed;
+    unclosed.AppendPoint(0.0, 0.0);
+    unclosed.AppendPoint(1.0, 0.0);
+    unclosed.AppendPoint(1.0, 1.0);
+    EXPECT_FALSE(algorithm_->Normalize(unclosed));
+    EXPECT_FALSE(algorithm_->Prepare(unclosed));
+
+    Polygon collapsed;
+    collapsed.AppendPoint(0.0, 0.0);
+    collapsed.AppendPoint(0.0, 1e-7f);
+    collapsed.AppendPoint(1e-7f, 1e-7f);
+    collapsed.AppendPoint(0.0, 0.0);
+    EXPECT_FALSE(algorithm_->Normalize(collapsed));
+    EXPECT_FALSE(algorithm_->error_message().empty());
+}
+
+TEST_F(PreparedPolygonTest, PreparedScanMatchesSimpleOnFile) {
+    auto points_and_polygons = reader_->ReadPointsAndPolygonsFromFile(polygons_file_path_);
+    for (const auto& [x, y, polygon] : points_and_polygons) {
+        auto expected = algorithm_->CalculateWindingNumber2D(x, y, polygon);
+        auto prepared = algorithm_->Prepare(polygon, Engine::kScan);
+        ASSERT_EQ(bool(expected), bool(prepared));
+        if (prepared) {
+            EXPECT_EQ(Engine::kScan, prepared->engine());
+            EXPECT_EQ(*expected, prepared->CalculateWindingNumber2D(x, y));
+        }
+    }
+}
+
+}  // namespace winding_number
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <quadtree.hpp>
+#include <winding.hpp>
+
+#include "engine_test.hpp"
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class QuadtreeTest : public EngineTest {
+protected:
+    // A large square with one finely detailed side, like a harbour on an otherwise straight border.
+    static Polygon MakeHarbour() {
+        Polygon p;
+        p.AppendPoint(0.0, 0.0);
+        p.AppendPoint(10.0, 0.0);
+        for (int i = 0; i <= 1000; ++i) {
+            float y = 10.f * i / 1000;
+            p.AppendPoint(10.f + 0.5f * std::sin(y * 7.f) * std::cos(y * 31.f), y);
+        }
+        p.AppendPoint(0.0, 10.0);
+        p.AppendPoint(0.0, 0.0);
+        return p;
+    }
+};
+
+TEST_F(QuadtreeTest, MatchesScanOnFilePolygons) {
+    ExpectMatchesScanOnFilePolygons(Engine::kQuadtree);
+}
+
+TEST_F(QuadtreeTest, MatchesScanOnHarbour) {
+    Polygon harbour = MakeHarbour();
+    auto scan = algorithm_->Prepare(harbour, Engine::kScan);
+    ASSERT_TRUE(scan);
+    auto normalized = algorithm_->Normalize(harbour);
+    ASSERT_TRUE(normalized);
+    QuadtreePolygon tree(normalized->polygon);
+
+    for (float x = -0.5f; x <= 11.f; x += 0.0371f) {
+        for (float y = -0.5f; y <= 11.f; y += 0.137f) {
+            EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), tree.CalculateWindingNumber2D(x, y))
+                    << "at (" << x << ", " << y << ")";
+        }
+    }
+}
+
+TEST_F(QuadtreeTest, RefinesOnlyWhereEdgesAreDense) {
+    auto normalized = algorithm_->Normalize(MakeHarbour());
+    ASSERT_TRUE(normalized);
+    QuadtreePolygon tree(normalized->polygon);
+
+    EXPECT_GT(tree.depth(), 2u);
+    EXPECT_GT(tree.inside_leaf_count(), 0u);
+    EXPECT_GT(tree.outside_leaf_count(), 0u);
+    EXPECT_GT(tree.boundary_leaf_count(), 0u);
+    // Every split adds four nodes, and leaves are the nodes that were never split.
+    EXPECT_EQ(1u, tree.node_count() % 4);
+    size_t split_count = tree.node_count() / 4;
+    EXPECT_EQ(tree.node_count() - split_count,
+              tree.inside_leaf_count() + tree.outside_leaf_count() + tree.boundary_leaf_count());
+    // A uniform grid at the same depth would need far more cells.
+    EXPECT_LT(tree.node_count(), size_t(1) << (2 * tree.depth()));
+
+    EXPECT_EQ(1, tree.CalculateWindingNumber2D(2.f, 5.f));
+    EXPECT_EQ(0, tree.CalculateWindingNumber2D(-2.f, 5.f));
+}
+
+}  // namespace winding_number
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <rectilinear.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class RectilinearTest : public ::testing::Test {
+protected:
+    RectilinearTest() : algorithm_(IWindingNumberAlgorithm::Create()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    static Polygon MakePolygon(const std::vector<std::pair<float, float>>& points, bool reversed = false) {
+        Polygon p;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto& [x, y] = points[reversed ? points.size() - 1 - i : i];
+            p.AppendPoint(x, y);
+        }
+        p.ClosePolygon();
+        return p;
+    }
+
+    // An L-shaped floor plan with a notch, a courtyard wall and a straight vertical run through several vertices.
+    static Polygon MakeFloorPlan(bool reversed) {
+        return MakePolygon({{0, 0}, {6, 0}, {6, 1}, {6, 2}, {4, 2}, {4, 3}, {6, 3}, {6, 5}, {3, 5}, {3, 4}, {2, 4},
+                            {2, 5}, {0, 5}, {0, 2.5}},
+                           reversed);
+    }
+
+    // Goes around its middle twice, crossing itself.
+    static Polygon MakeSpiral() {
+        return MakePolygon({{0, 0}, {4, 0}, {4, 4}, {1, 4}, {1, 1}, {3, 1}, {3, 3}, {0, 3}});
+    }
+
+    static Polygon MakeStaircase(int steps) {
+        std::vector<std::pair<float, float>> points = {{0, 0}};
+        for (int i = 0; i < steps; ++i) {
+            points.emplace_back(i + 1.f, float(i));
+            points.emplace_back(i + 1.f, i + 1.f);
+        }
+        points.emplace_back(0.f, float(steps));
+        return MakePolygon(points);
+    }
+
+    // Alternates ever wider horizontal sweeps, so its horizontal edges cover a quadratic number of slabs.
+    static Polygon MakeZigzag(int sweeps) {
+        std::vector<std::pair<float, float>> points = {{0, 0}};
+        float x = 0.f;
+        for (int i = 1; i <= sweeps; ++i) {
+            x = (i % 2 ? 1.f : -1.f) * float(i);
+            points.emplace_back(x, float(i - 1));
+            points.emplace_back(x, float(i));
+        }
+        points.emplace_back(0.f, float(sweeps));
+        return MakePolygon(points);
+    }
+
+    void ExpectMatchesScan(const Polygon& polygon) {
+        auto scan = algorithm_->Prepare(polygon, Engine::kScan);
+        auto rectilinear = algorithm_->Prepare(polygon, Engine::kRectilinear);
+        ASSERT_TRUE(scan);
+        ASSERT_TRUE(rectilinear);
+        EXPECT_EQ(Engine::kRectilinear, rectilinear->engine());
+
+        // A grid aligned with the polygon's coordinates puts many points on edges and vertices.
+        for (float x = -1.f; x <= 7.f; x += 0.25f) {
+            for (float y = -1.f; y <= 6.f; y += 0.25f) {
+                for (float offset : {0.f, 1e-7f, -1e-7f}) {
+                    EXPECT_EQ(scan->CalculateWindingNumber2D(x + offset, y),
+                              rectilinear->CalculateWindingNumber2D(x + offset, y))
+                            << "at (" << x + offset << ", " << y << ")";
+                }
+            }
+        }
+    }
+
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+};
+
+TEST_F(RectilinearTest, MatchesScan) {
+    ExpectMatchesScan(MakeFloorPlan(false));
+    ExpectMatchesScan(MakeFloorPlan(true));
+    ExpectMatchesScan(MakeSpiral());
+    ExpectMatchesScan(MakeStaircase(6));
+    ExpectMatchesScan(MakeZigzag(6));
+
+    auto spiral = algorithm_->Prepare(MakeSpiral(), Engine::kRectilinear);
+    ASSERT_TRUE(spiral);
+    EXPECT_EQ(2, spiral->CalculateWindingNumber2D(2.f, 2.f));
+}
+
+TEST_F(RectilinearTest, DetectsRectilinearPolygons) {
+    EXPECT_TRUE(RectilinearPolygon::IsRectilinear(MakeFloorPlan(false)));
+    Polygon triangle = MakePolygon({{0, 0}, {1, 0}, {0, 1}});
+    EXPECT_FALSE(RectilinearPolygon::IsRectilinear(triangle));
+    EXPECT_FALSE(algorithm_->Prepare(triangle, Engine::kRectilinear));
+    EXPECT_FALSE(algorithm_->error_message().empty());
+
+    auto normalized = algorithm_->Normalize(MakeFloorPlan(false));
+    ASSERT_TRUE(normalized);
+    RectilinearPolygon floor_plan(normalized->polygon);
+    EXPECT_EQ(4u, floor_plan.slab_count());
+}
+
+TEST_F(RectilinearTest, SelectedAutomaticallyWhenSlabsStaySmall) {
+    auto floor_plan = algorithm_->Prepare(MakeFloorPlan(false));
+    ASSERT_TRUE(floor_plan);
+    EXPECT_EQ(Engine::kRectilinear, floor_plan->engine());
+
+    auto zigzag = MakeZigzag(200);
+    EXPECT_GT(RectilinearPolygon::CountSlabEntries(zigzag), 32 * zigzag.size());
+    auto prepared = algorithm_->Prepare(zigzag);
+    ASSERT_TRUE(prepared);
+    EXPECT_NE(Engine::kRectilinear, prepared->engine());
+}
+
+}  // namespace winding_number
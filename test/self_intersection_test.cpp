@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <self_intersection.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class SelfIntersectionTest : public ::testing::Test {
+protected:
+    SelfIntersectionTest() : algorithm_(IWindingNumberAlgorithm::Create()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    static Polygon MakePolygon(std::initializer_list<std::pair<float, float>> points) {
+        Polygon p;
+        for (const auto& [x, y] : points) {
+            p.AppendPoint(x, y);
+        }
+        p.ClosePolygon();
+        return p;
+    }
+
+    // Checks every pair of edges, the way the sweep is meant to but in O(n^2).
+    static bool BruteForceIsSimple(const Polygon& polygon) {
+        size_t edge_count = polygon.size() - 1;
+        for (size_t i = 0; i < edge_count; ++i) {
+            for (size_t j = i + 1; j < edge_count; ++j) {
+                bool adjacent = j == i + 1 || (i == 0 && j == edge_count - 1);
+                double px = polygon.x_vec_[i], py = polygon.y_vec_[i];
+                double qx = polygon.x_vec_[i + 1], qy = polygon.y_vec_[i + 1];
+                double rx = polygon.x_vec_[j], ry = polygon.y_vec_[j];
+                double sx = polygon.x_vec_[j + 1], sy = polygon.y_vec_[j + 1];
+                auto orientation = [](double ax, double ay, double bx, double by, double cx, double cy) {
+                    double value = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+                    return (value > 0) - (value < 0);
+                };
+                auto on_segment = [](double ax, double ay, double bx, double by, double cx, double cy) {
+                    return std::min(ax, bx) <= cx && cx <= std::max(ax, bx) && std::min(ay, by) <= cy &&
+                           cy <= std::max(ay, by);
+                };
+                int d1 = orientation(px, py, qx, qy, rx, ry), d2 = orientation(px, py, qx, qy, sx, sy);
+                int d3 = orientation(rx, ry, sx, sy, px, py), d4 = orientation(rx, ry, sx, sy, qx, qy);
+                bool intersect = (d1 * d2 < 0 && d3 * d4 < 0) || (d1 == 0 && on_segment(px, py, qx, qy, rx, ry)) ||
+                                 (d2 == 0 && on_segment(px, py, qx, qy, sx, sy)) ||
+                                 (d3 == 0 && on_segment(rx, ry, sx, sy, px, py)) ||
+                                 (d4 == 0 && on_segment(rx, ry, sx, sy, qx, qy));
+                if (!intersect) {
+                    continue;
+                }
+                if (!adjacent) {
+                    return false;
+                }
+                // Adjacent edges only count when they run back over each other.
+                bool wraps = i == 0 && j == edge_count - 1 && edge_count > 2;
+                double vx = wraps ? px : rx, vy = wraps ? py : ry;
+                double ax = wraps ? rx : px, ay = wraps ? ry : py;
+                double bx = wraps ? qx : sx, by = wraps ? qy : sy;
+                if (orientation(ax, ay, vx, vy, bx, by) == 0 && (ax - vx) * (bx - vx) + (ay - vy) * (by - vy) > 0) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+};
+
+TEST_F(SelfIntersectionTest, ClassifiesBasicShapes) {
+    EXPECT_TRUE(IsSimple(MakePolygon({{0, 0}, {1, 0}, {1, 1}, {0, 1}})));
+    EXPECT_TRUE(IsSimple(MakePolygon({{0, 0}, {4, 0}, {4, 4}, {2, 1}, {0, 4}})));
+    EXPECT_TRUE(IsSimple(MakePolygon({{0, 0}, {1, 0}, {1, 1}, {1, 2}, {0, 2}})));  // A straight run through a vertex.
+
+    auto bowtie = FindSelfIntersection(MakePolygon({{0, 0}, {1, 1}, {1, 0}, {0, 1}}));
+    ASSERT_TRUE(bowtie);
+    EXPECT_EQ(2u, std::max(bowtie->first, bowtie->second) - std::min(bowtie->first, bowtie->second));
+
+    // Touching at a vertex, doubling back along an edge, and a vertical edge crossing a horizontal one.
+    EXPECT_FALSE(IsSimple(MakePolygon({{0, 0}, {2, 0}, {1, 1}, {2, 2}, {0, 2}, {1, 1}})));
+    EXPECT_FALSE(IsSimple(MakePolygon({{0, 0}, {2, 0}, {1, 0}, {1, 1}})));
+    EXPECT_FALSE(IsSimple(MakePolygon({{0, 0}, {2, 0}, {2, 2}, {1, 2}, {1, -1}, {0, -1}})));
+    EXPECT_FALSE(IsSimple(MakePolygon({{0, 0}, {1, 0}, {0, 0}})));
+}
+
+TEST_F(SelfIntersectionTest, MatchesBruteForceOnRandomPolygons) {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> coordinate(0, 6);
+    size_t simple_count = 0;
+    for (int trial = 0; trial < 3000; ++trial) {
+        Polygon polygon;
+        size_t vertex_count = 3 + trial % 6;
+        for (size_t i = 0; i < vertex_count; ++i) {
+            polygon.AppendPoint(float(coordinate(generator)), float(coordinate(generator)));
+        }
+        polygon.AppendPoint(polygon.x_vec_[0], polygon.y_vec_[0]);
+        bool duplicate = false;
+        for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+            duplicate |= polygon.x_vec_[i] == polygon.x_vec_[i + 1] && polygon.y_vec_[i] == polygon.y_vec_[i + 1];
+        }
+        if (duplicate) continue;
+        bool expected = BruteForceIsSimple(polygon);
+        simple_count += expected;
+        EXPECT_EQ(expected, IsSimple(polygon)) << "trial " << trial;
+    }
+    EXPECT_GT(simple_count, 100u);
+}
+
+TEST_F(SelfIntersectionTest, PreparedPolygonRecordsSimplicity) {
+    Polygon star;
+    for (int i = 0; i <= 5; ++i) {
+        float angle = 4.f * float(M_PI) * i / 5;
+        star.AppendPoint(std::cos(angle), std::sin(angle));
+    }
+    auto prepared = algorithm_->Prepare(star);
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ(false, prepared->simple());
+
+    Polygon circle;
+    for (int i = 0; i <= 200; ++i) {
+        float angle = 2.f * float(M_PI) * (i % 200) / 200;
+        circle.AppendPoint(std::cos(angle), std::sin(angle));
+    }
+    for (Engine engine : {Engine::kAutomatic, Engine::kConvex, Engine::kStar}) {
+        prepared = algorithm_->Prepare(circle, engine);
+        ASSERT_TRUE(prepared);
+        EXPECT_EQ(true, prepared->simple());
+    }
+    // Engines that do not depend on simplicity skip the check.
+    for (Engine engine : {Engine::kScan, Engine::kEdgeIntervalTree, Engine::kQuadtree, Engine::kMonotoneChain}) {
+        prepared = algorithm_->Prepare(circle, engine);
+        ASSERT_TRUE(prepared);
+        EXPECT_EQ(std::nullopt, prepared->simple());
+    }
+}
+
+}  // namespace winding_number
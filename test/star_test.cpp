@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <poly_io.hpp>
+#include <prepared.hpp>
+#include <star.hpp>
+#include <winding.hpp>
+
+namespace winding_number {
+
+using poly::Polygon;
+
+class StarTest : public ::testing::Test {
+protected:
+    StarTest() : algorithm_(IWindingNumberAlgorithm::Create()) {
+        algorithm_->tolerance(1e-6f);
+    }
+
+    // A flower with many petals about (1, 1), far too wavy for the convex or monotone chain engines.
+    static Polygon MakeFlower(bool clockwise) {
+        Polygon p;
+        const int count = 300;
+        for (int i = 0; i <= count; ++i) {
+            float angle = 2.f * float(M_PI) * (i % count) / count * (clockwise ? -1.f : 1.f);
+            float radius = 2.f + 0.9f * std::sin(31.f * angle);
+            p.AppendPoint(1.f + radius * std::cos(angle), 1.f + radius * std::sin(angle));
+        }
+        return p;
+    }
+
+    // A radio coverage sector: an apex with a ragged arc in front of it.
+    static Polygon MakeSector() {
+        Polygon p;
+        p.AppendPoint(-1.f, 0.f);
+        for (int i = 0; i <= 120; ++i) {
+            float angle = float(M_PI) / 3.f * (i / 60.f - 1.f);
+            float radius = 4.f + 0.5f * std::cos(17.f * angle);
+            p.AppendPoint(-1.f + radius * std::cos(angle), radius * std::sin(angle));
+        }
+        p.AppendPoint(-1.f, 0.f);
+        return p;
+    }
+
+    // A circle about (1, 1) with a tiny upward jog at every vertex of its right half. The scan counts points beside
+    // such short vertical edges as on them, much farther out than the edges themselves could be rounded.
+    static Polygon MakeJoggedCircle() {
+        Polygon p;
+        const int count = 120;
+        for (int i = 0; i <= count; ++i) {
+            float angle = 2.f * float(M_PI) * (i % count) / count;
+            float x = 1.f + 2.f * std::cos(angle), y = 1.f + 2.f * std::sin(angle);
+            p.AppendPoint(x, y);
+            if (i < count && std::cos(angle) > 0.1f) {
+                p.AppendPoint(x, y + 1e-3f);
+            }
+        }
+        return p;
+    }
+
+    void ExpectMatchesScan(const Polygon& polygon) {
+        auto scan = algorithm_->Prepare(polygon, Engine::kScan);
+        auto star = algorithm_->Prepare(polygon, Engine::kStar);
+        ASSERT_TRUE(scan);
+        ASSERT_TRUE(star);
+        EXPECT_EQ(Engine::kStar, star->engine());
+
+        for (float x = -2.f; x <= 4.5f; x += 0.0625f) {
+            for (float y = -2.5f; y <= 4.f; y += 0.0625f) {
+                EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), star->CalculateWindingNumber2D(x, y))
+                        << "at (" << x << ", " << y << ")";
+            }
+        }
+        for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+            float x = polygon.x_vec_[i], y = polygon.y_vec_[i];
+            EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), star->CalculateWindingNumber2D(x, y));
+            x = 0.5f * (x + polygon.x_vec_[i + 1]);
+            y = 0.5f * (y + polygon.y_vec_[i + 1]);
+            EXPECT_EQ(scan->CalculateWindingNumber2D(x, y), star->CalculateWindingNumber2D(x, y));
+        }
+        // Beside upward vertical edges, as far out as the scan still counts points as on them.
+        for (size_t i = 0; i + 1 < polygon.size(); ++i) {
+            float x = polygon.x_vec_[i], low = polygon.y_vec_[i], high = polygon.y_vec_[i + 1];
+            if (x != polygon.x_vec_[i + 1] || low >= high) continue;
+            float offset = 0.5e-6f / (high - low);
+            for (float dx : {-offset, offset}) {
+                float y = 0.5f * (low + high);
+                EXPECT_EQ(scan->CalculateWindingNumber2D(x + dx, y), star->CalculateWindingNumber2D(x + dx, y))
+                        << "at (" << x + dx << ", " << y << ")";
+            }
+        }
+    }
+
+    std::unique_ptr<IWindingNumberAlgorithm> algorithm_;
+};
+
+TEST_F(StarTest, FindsKernelPoint) {
+    Polygon flower = MakeFlower(false);
+    auto kernel = StarPolygon::FindKernelPoint(flower);
+    ASSERT_TRUE(kernel);
+    EXPECT_TRUE(StarPolygon::IsKernelPoint(flower, *kernel));
+    EXPECT_NEAR(1.f, kernel->first, 0.5f);
+    EXPECT_NEAR(1.f, kernel->second, 0.5f);
+    EXPECT_TRUE(StarPolygon::FindKernelPoint(MakeSector()));
+    EXPECT_TRUE(StarPolygon::FindKernelPoint(MakeJoggedCircle()));
+
+    // The search gives up on kernels with more corners than asked for.
+    EXPECT_FALSE(StarPolygon::FindKernelPoint(flower, 8));
+
+    // A U shape has no point that sees both arms.
+    Polygon u_shape;
+    for (auto [x, y] : {std::pair{0.f, 0.f}, {3.f, 0.f}, {3.f, 3.f}, {2.f, 3.f}, {2.f, 1.f}, {1.f, 1.f}, {1.f, 3.f},
+                        {0.f, 3.f}, {0.f, 0.f}}) {
+        u_shape.AppendPoint(x, y);
+    }
+    EXPECT_FALSE(StarPolygon::FindKernelPoint(u_shape));
+    EXPECT_FALSE(algorithm_->Prepare(u_shape, Engine::kStar));
+    EXPECT_FALSE(algorithm_->error_message().empty());
+
+    // Every edge of a pentagram sees its center on the same side, but it goes around twice.
+    Polygon pentagram;
+    for (int i = 0; i <= 5; ++i) {
+        float angle = 4.f * float(M_PI) * i / 5;
+        pentagram.AppendPoint(std::cos(angle), std::sin(angle));
+    }
+    EXPECT_FALSE(StarPolygon::IsKernelPoint(pentagram, {0.f, 0.f}));
+    EXPECT_FALSE(StarPolygon::FindKernelPoint(pentagram));
+}
+
+TEST_F(StarTest, MatchesScan) {
+    ExpectMatchesScan(MakeFlower(false));
+    ExpectMatchesScan(MakeFlower(true));
+    ExpectMatchesScan(MakeSector());
+    ExpectMatchesScan(MakeJoggedCircle());
+}
+
+TEST_F(StarTest, SelectedAutomaticallyForStarShapedPolygons) {
+    auto prepared = algorithm_->Prepare(MakeFlower(true));
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ(Engine::kStar, prepared->engine());
+    EXPECT_EQ(-1, prepared->CalculateWindingNumber2D(1.f, 1.f));
+    EXPECT_EQ(0, prepared->CalculateWindingNumber2D(4.f, 4.f));
+}
+
+}  // namespace winding_number